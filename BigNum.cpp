@@ -28,11 +28,78 @@
 #include "BigNum.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <new>
 #include <stdexcept>
+#include <thread>
 #include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#	else
+#		include <cpuid.h>
+#	endif
+#	include <immintrin.h>
+#endif
+
+#ifdef _BIGNUM_THRESHOLDS_HEADER
+#	include _BIGNUM_THRESHOLDS_HEADER
+#endif
+
+/////////////////////////////////////////////////////////////////
+///// Macros
+/////////////////////////////////////////////////////////////////
+
+#ifdef _BIGNUM_STATS
+#	define _BIGNUM_STATS_ALLOCATE(where, size) _BIGNUM_DETAILS::stats_allocate(bigint_stats::site::where, size)
+#	define _BIGNUM_STATS_REALLOCATE(where, size) _BIGNUM_DETAILS::stats_reallocate(bigint_stats::site::where, size)
+#	define _BIGNUM_STATS_OPERATION(what, size) _BIGNUM_DETAILS::stats_operation(bigint_stats::operation::what, size)
+#else
+#	define _BIGNUM_STATS_ALLOCATE(where, size) static_cast<void>(0)
+#	define _BIGNUM_STATS_REALLOCATE(where, size) static_cast<void>(0)
+#	define _BIGNUM_STATS_OPERATION(what, size) static_cast<void>(0)
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	define _BIGNUM_X86_64
+#endif
+
+#ifndef _BIGNUM_KARATSUBA_THRESHOLD
+#	define _BIGNUM_KARATSUBA_THRESHOLD 64
+#endif
+#ifndef _BIGNUM_TOOM3_THRESHOLD
+#	define _BIGNUM_TOOM3_THRESHOLD 1024
+#endif
+#ifndef _BIGNUM_RATIONAL_THRESHOLD
+#	define _BIGNUM_RATIONAL_THRESHOLD 64
+#endif
+
+#ifdef _MSC_VER
+#	define _BIGNUM_TARGET(features)
+#else
+#	define _BIGNUM_TARGET(features) __attribute__((target(features)))
+#endif
 
 /////////////////////////////////////////////////////////////////
 ///// Definitions
@@ -43,861 +110,6120 @@ namespace _BIGNUM_HAS_NAMESPACE
 {
 #endif
 
-bigint::bigint(std::int32_t integer)
-	: capacity_(integer == std::numeric_limits<std::int32_t>::min() ? 2 : 1)
-{
-	data_ = reinterpret_cast<block_type*>(std::calloc(capacity_, sizeof(block_type)));
+_BIGNUM_DETAILS_BEGIN
 
-	if (!data_)
-	{
-		capacity_ = 0;
-		throw std::bad_alloc();
-	}
+#ifdef _BIGNUM_STATS
+struct stats_block
+{
+	std::atomic<bigint_stats::counter_type> allocations[bigint_stats::sites];
+	std::atomic<bigint_stats::counter_type> reallocations[bigint_stats::sites];
+	std::atomic<bigint_stats::counter_type> bytes[bigint_stats::sites];
+	std::atomic<bigint_stats::counter_type> calls[bigint_stats::operations];
+	std::atomic<bigint_stats::counter_type> sizes[bigint_stats::operations][bigint_stats::buckets];
 
-	data_[0] = static_cast<block_type>(integer);
+	stats_block();
+	~stats_block();
+};
 
-	if (integer < 0)
-	{
-		sign_ = true;
-		if ((data_[0] = ~data_[0] + 1) == 0) // Overflow
-		{
-			data_[1] = 1;
-		}
-	}
-}
-bigint::bigint(std::uint32_t integer)
-	: capacity_(1)
+struct stats_registry
 {
-	data_ = reinterpret_cast<block_type*>(std::calloc(1, sizeof(block_type)));
+	std::mutex mutex;
+	std::vector<const stats_block*> blocks;
+	bigint_stats retired;
+	bigint_stats baseline;
+};
 
-	if (!data_)
-	{
-		capacity_ = 0;
-		throw std::bad_alloc();
-	}
+stats_registry& get_stats_registry()
+{
+	// Never destroyed: threads may still retire their blocks during static destruction.
+	static stats_registry* const registry = new stats_registry();
 
-	*data_ = integer;
+	return *registry;
 }
-bigint::bigint(std::int64_t integer)
-	: capacity_(integer == std::numeric_limits<std::int32_t>::min() ? 3 : 2)
-{
-	data_ = reinterpret_cast<block_type*>(std::calloc(capacity_, sizeof(block_type)));
 
-	if (!data_)
+void add_stats(bigint_stats& stats, const stats_block& block) noexcept
+{
+	for (std::size_t i = 0; i < bigint_stats::sites; ++i)
 	{
-		capacity_ = 0;
-		throw std::bad_alloc();
+		stats.allocations[i] += block.allocations[i].load(std::memory_order_relaxed);
+		stats.reallocations[i] += block.reallocations[i].load(std::memory_order_relaxed);
+		stats.bytes[i] += block.bytes[i].load(std::memory_order_relaxed);
 	}
-
-	data_[0] = static_cast<block_type>(static_cast<std::uint64_t>(integer) & 0xFFFFFFFF);
-	data_[1] = static_cast<block_type>(static_cast<std::uint64_t>(integer) >> 32);
-
-	if (integer < 0)
+	for (std::size_t i = 0; i < bigint_stats::operations; ++i)
 	{
-		sign_ = true;
-		data_[1] = ~data_[1];
-		if ((data_[0] = ~data_[0] + 1) == 0) // Overflow
+		stats.calls[i] += block.calls[i].load(std::memory_order_relaxed);
+
+		for (std::size_t j = 0; j < bigint_stats::buckets; ++j)
 		{
-			if ((data_[1] += 1) == 0) // Overflow
-			{
-				data_[2] = 1;
-			}
+			stats.sizes[i][j] += block.sizes[i][j].load(std::memory_order_relaxed);
 		}
 	}
 }
-bigint::bigint(std::uint64_t integer)
-	: capacity_(2)
+bigint_stats collect_stats(stats_registry& registry)
 {
-	data_ = reinterpret_cast<block_type*>(std::calloc(2, sizeof(block_type)));
+	bigint_stats stats = registry.retired;
 
-	if (!data_)
+	for (const stats_block* block : registry.blocks)
 	{
-		capacity_ = 0;
-		throw std::bad_alloc();
+		add_stats(stats, *block);
 	}
 
-	data_[0] = static_cast<block_type>(integer & 0xFFFFFFFF);
-	data_[1] = static_cast<block_type>(integer >> 32);
+	return stats;
 }
-bigint::bigint(const bigint& integer)
-	: capacity_(integer.capacity_), sign_(integer.sign_)
+
+stats_block::stats_block()
 {
-	if (integer.capacity_)
+	for (std::size_t i = 0; i < bigint_stats::sites; ++i)
 	{
-		data_ = reinterpret_cast<block_type*>(std::calloc(capacity_, sizeof(block_type)));
+		allocations[i].store(0, std::memory_order_relaxed);
+		reallocations[i].store(0, std::memory_order_relaxed);
+		bytes[i].store(0, std::memory_order_relaxed);
+	}
+	for (std::size_t i = 0; i < bigint_stats::operations; ++i)
+	{
+		calls[i].store(0, std::memory_order_relaxed);
 
-		if (!data_)
+		for (std::size_t j = 0; j < bigint_stats::buckets; ++j)
 		{
-			capacity_ = 0;
-			sign_ = false;
-			throw std::bad_alloc();
+			sizes[i][j].store(0, std::memory_order_relaxed);
 		}
-
-		std::copy(integer.data_, integer.data_ + integer.capacity_, data_);
 	}
+
+	stats_registry& registry = get_stats_registry();
+	std::lock_guard<std::mutex> guard(registry.mutex);
+
+	registry.blocks.push_back(this);
 }
-bigint::bigint(const bigint& integer, size_type new_capacity)
-	: capacity_(new_capacity), sign_(integer.sign_)
+stats_block::~stats_block()
 {
-	if (capacity_ < integer.capacity_)
-	{
-		capacity_ = 0;
-		sign_ = false;
-		throw std::invalid_argument("new_capacity < integer.capacity()");
-	}
+	stats_registry& registry = get_stats_registry();
+	std::lock_guard<std::mutex> guard(registry.mutex);
 
-	data_ = reinterpret_cast<block_type*>(std::calloc(capacity_, sizeof(block_type)));
+	add_stats(registry.retired, *this);
+	registry.blocks.erase(std::find(registry.blocks.begin(), registry.blocks.end(), this));
+}
 
-	if (!data_)
-	{
-		capacity_ = 0;
-		sign_ = false;
-		throw std::bad_alloc();
-	}
+stats_block& local_stats()
+{
+	thread_local stats_block block;
 
-	std::copy(integer.data_, integer.data_ + integer.capacity_, data_);
-	std::fill(data_ + integer.capacity_, data_ + capacity_, 0);
+	return block;
 }
-bigint::bigint(bigint&& integer) noexcept
-	: data_(integer.data_), capacity_(integer.capacity_), sign_(integer.sign_)
+
+// Only the owning thread writes its block, so a plain load and store is enough.
+void stats_add(std::atomic<bigint_stats::counter_type>& counter, bigint_stats::counter_type value) noexcept
 {
-	integer.data_ = nullptr;
-	integer.capacity_ = 0;
-	integer.sign_ = false;
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
 }
-bigint::~bigint()
+void stats_allocate(bigint_stats::site site, std::size_t size)
 {
-	reset();
-}
+	stats_block& block = local_stats();
 
-bigint& bigint::operator=(const bigint& integer)
+	stats_add(block.allocations[static_cast<std::size_t>(site)], 1);
+	stats_add(block.bytes[static_cast<std::size_t>(site)], size);
+}
+void stats_reallocate(bigint_stats::site site, std::size_t size)
 {
-	if (capacity_ < integer.capacity_)
-	{
-		block_type* const old_data = data_;
-		const size_type old_capacity = capacity_;
-
-		data_ = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * integer.capacity_));
-		capacity_ = integer.capacity_;
+	stats_block& block = local_stats();
 
-		if (!data_)
-		{
-			data_ = old_data;
-			capacity_ = old_capacity;
-			throw std::bad_alloc();
-		}
+	stats_add(block.reallocations[static_cast<std::size_t>(site)], 1);
+	stats_add(block.bytes[static_cast<std::size_t>(site)], size);
+}
+void stats_operation(bigint_stats::operation operation, std::size_t size)
+{
+	stats_block& block = local_stats();
+	std::size_t bucket = 0;
 
-		std::fill(data_ + old_capacity, data_ + capacity_, 0);
+	for (; size; size >>= 1)
+	{
+		++bucket;
 	}
-		
-	sign_ = integer.sign_;
-	std::copy(integer.data_, integer.data_ + integer.capacity_, data_);
 
-	if (capacity_ > integer.capacity_)
+	stats_add(block.calls[static_cast<std::size_t>(operation)], 1);
+	stats_add(block.sizes[static_cast<std::size_t>(operation)][bucket], 1);
+}
+#endif
+
+bigint::size_type used_size(const bigint::block_type* data, bigint::size_type capacity) noexcept
+{
+	while (capacity && !data[capacity - 1])
 	{
-		std::fill(data_ + integer.capacity_, data_ + capacity_, 0);
+		--capacity;
 	}
 
-	return *this;
+	return capacity;
 }
-bigint& bigint::operator=(bigint&& integer) noexcept
-{
-	data_ = integer.data_;
-	capacity_ = integer.capacity_;
-	sign_ = integer.sign_;
 
-	integer.data_ = nullptr;
-	integer.capacity_ = 0;
-	integer.sign_ = false;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool host_little_endian = false;
+#else
+constexpr bool host_little_endian = true;
+#endif
 
-	return *this;
-}
-bool bigint::operator==(const bigint& integer) const noexcept
+bigint::block_type byte_swap(bigint::block_type block) noexcept
 {
-	if (this == &integer) return true;
-	if (data_ == integer.data_ && data_ == nullptr) return true;
+#if defined(__GNUC__)
+	return __builtin_bswap32(block);
+#elif defined(_MSC_VER)
+	return _byteswap_ulong(block);
+#else
+	return (block >> 24) | ((block >> 8) & 0xFF00) | ((block << 8) & 0xFF0000) | (block << 24);
+#endif
+}
 
-	const size_type min_capacity = std::min(capacity_, integer.capacity_);
+bigint::block_type add_n_generic(bigint::block_type* result, const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size, bigint::block_type carry) noexcept
+{
+	std::uint64_t sum = carry;
 
-	for (size_type i = 0; i < min_capacity; ++i)
+	for (bigint::size_type i = 0; i < size; ++i)
 	{
-		if (data_[i] != integer.data_[i]) return false;
+		sum += static_cast<std::uint64_t>(a[i]) + b[i];
+		result[i] = static_cast<bigint::block_type>(sum);
+		sum >>= 32;
 	}
 
-	const size_type other_capacity = std::max(capacity_, integer.capacity_) - min_capacity;
-	block_type* other_data = (capacity_ > integer.capacity_ ? data_ : integer.data_) + min_capacity;
-	block_type* const other_data_end = other_data + other_capacity;
+	return static_cast<bigint::block_type>(sum);
+}
+bigint::block_type sub_n_generic(bigint::block_type* result, const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size, bigint::block_type borrow) noexcept
+{
+	std::uint64_t difference = 0;
 
-	for (; other_data < other_data_end; ++other_data)
+	for (bigint::size_type i = 0; i < size; ++i)
 	{
-		if (*other_data != 0) return false;
+		difference = static_cast<std::uint64_t>(a[i]) - b[i] - borrow;
+		result[i] = static_cast<bigint::block_type>(difference);
+		borrow = static_cast<bigint::block_type>(difference >> 63);
 	}
 
-	return sign_ == integer.sign_;
+	return borrow;
 }
-bool bigint::operator!=(const bigint& integer) const noexcept
+bigint::block_type mul_1_generic(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, bigint::block_type b) noexcept
 {
-	if (this == &integer) return false;
-	if (data_ == integer.data_ && data_ == nullptr) return false;
-
-	const size_type min_capacity = std::min(capacity_, integer.capacity_);
+	std::uint64_t carry = 0;
 
-	for (size_type i = 0; i < min_capacity; ++i)
+	for (bigint::size_type i = 0; i < size; ++i)
 	{
-		if (data_[i] != integer.data_[i]) return true;
+		carry += static_cast<std::uint64_t>(a[i]) * b;
+		result[i] = static_cast<bigint::block_type>(carry);
+		carry >>= 32;
 	}
 
-	const size_type other_capacity = std::max(capacity_, integer.capacity_) - min_capacity;
-	block_type* other_data = (capacity_ > integer.capacity_ ? data_ : integer.data_) + min_capacity;
-	block_type* const other_data_end = other_data + other_capacity;
+	return static_cast<bigint::block_type>(carry);
+}
+bigint::block_type addmul_1_generic(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, bigint::block_type b) noexcept
+{
+	std::uint64_t carry = 0;
 
-	for (; other_data < other_data_end; ++other_data)
+	for (bigint::size_type i = 0; i < size; ++i)
 	{
-		if (*other_data != 0) return true;
+		carry += static_cast<std::uint64_t>(a[i]) * b + result[i];
+		result[i] = static_cast<bigint::block_type>(carry);
+		carry >>= 32;
 	}
 
-	return sign_ != integer.sign_;
+	return static_cast<bigint::block_type>(carry);
 }
-bool bigint::operator>(const bigint& integer) const noexcept
+void mul_basecase_generic(bigint::block_type* result, const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size) noexcept
 {
-	if (!capacity_)
+	result[a_size] = mul_1_generic(result, a, a_size, b[0]);
+
+	for (bigint::size_type i = 1; i < b_size; ++i)
 	{
-		if (!integer.capacity_ || integer.zero()) return false;
-		else return integer.sign_;
+		result[a_size + i] = addmul_1_generic(result + i, a, a_size, b[i]);
 	}
-	else if (!integer.capacity_)
+}
+bigint::block_type lshift_generic(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, unsigned shift) noexcept
+{
+	const bigint::block_type out = a[size - 1] >> (32 - shift);
+
+	for (bigint::size_type i = size - 1; i > 0; --i)
 	{
-		if (zero()) return false;
-		else return !sign_;
+		result[i] = (a[i] << shift) | (a[i - 1] >> (32 - shift));
 	}
-	else if (sign_ != integer.sign_)
-	{
-		const bool this_zero = zero();
-		const bool integer_zero = integer.zero();
 
-		if (!this_zero && !integer_zero) return sign_ < integer.sign_;
-		else if (this_zero && !integer_zero) return integer.sign_;
-		else if (!this_zero && integer_zero) return !sign_;
-		else return false;
-	}
+	result[0] = a[0] << shift;
 
-	const bigint* smaller;
-	const bigint* larger;
+	return out;
+}
+bigint::block_type rshift_generic(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, unsigned shift) noexcept
+{
+	const bigint::block_type out = a[0] << (32 - shift);
 
-	if (capacity_ >= integer.capacity_)
+	for (bigint::size_type i = 0; i < size - 1; ++i)
 	{
-		larger = this;
-		smaller = &integer;
+		result[i] = (a[i] >> shift) | (a[i + 1] << (32 - shift));
 	}
-	else
+
+	result[size - 1] = a[size - 1] >> shift;
+
+	return out;
+}
+int compare_n_generic(const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size) noexcept
+{
+	for (bigint::size_type i = size; i-- > 0;)
 	{
-		larger = &integer;
-		smaller = this;
+		if (a[i] != b[i]) return a[i] > b[i] ? 1 : -1;
 	}
 
-	const size_type limit = smaller->capacity_;
+	return 0;
+}
+
+#ifdef _BIGNUM_X86_64
+std::uint64_t load_limb(const bigint::block_type* blocks) noexcept
+{
+	std::uint64_t limb;
 
-	bool result = false;
+	std::memcpy(&limb, blocks, sizeof(limb));
 
-	for (size_type i = larger->capacity_ - 1; i >= limit; --i)
-	{
-		if (larger->data_[i])
-		{
-			result = larger == this;
-			goto exit;
-		}
-	}
-	
-	for (size_type i = limit - 1; i >= 0; --i)
+	return limb;
+}
+void store_limb(bigint::block_type* blocks, std::uint64_t limb) noexcept
+{
+	std::memcpy(blocks, &limb, sizeof(limb));
+}
+
+// The limb kernels work on pairs of blocks as 64-bit limbs. size is in limbs and must not be zero.
+#	ifdef _MSC_VER
+unsigned char add_limbs(bigint::block_type* result, const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size, unsigned char carry) noexcept
+{
+	for (bigint::size_type i = 0; i < size * 2; i += 2)
 	{
-		if (data_[i] > integer.data_[i])
-		{
-			result = true;
-			goto exit;
-		}
-		else if (data_[i] < integer.data_[i])
-		{
-			result = false;
-			goto exit;
-		}
-		else if (i == 0)
-		{
-			return false;
-		}
+		unsigned long long sum;
+
+		carry = _addcarry_u64(carry, load_limb(a + i), load_limb(b + i), &sum);
+		store_limb(result + i, sum);
 	}
 
-exit:
-	return sign_ ? !result : result;
+	return carry;
 }
-bool bigint::operator>=(const bigint& integer) const noexcept
+unsigned char sub_limbs(bigint::block_type* result, const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size, unsigned char borrow) noexcept
 {
-	if (!capacity_)
+	for (bigint::size_type i = 0; i < size * 2; i += 2)
 	{
-		if (!integer.capacity_ || integer.zero()) return true;
-		else return integer.sign_;
+		unsigned long long difference;
+
+		borrow = _subborrow_u64(borrow, load_limb(a + i), load_limb(b + i), &difference);
+		store_limb(result + i, difference);
 	}
-	else if (!integer.capacity_)
+
+	return borrow;
+}
+std::uint64_t mul_1_limbs(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, std::uint64_t b) noexcept
+{
+	unsigned long long high = 0;
+	unsigned char carry = 0;
+
+	for (bigint::size_type i = 0; i < size * 2; i += 2)
 	{
-		if (zero()) return true;
-		else return !sign_;
+		unsigned long long low;
+		const unsigned long long previous = high;
+
+		low = _mulx_u64(load_limb(a + i), b, &high);
+		carry = _addcarryx_u64(carry, low, previous, &low);
+		store_limb(result + i, low);
 	}
-	else if (sign_ != integer.sign_)
+
+	return high + carry;
+}
+std::uint64_t addmul_1_limbs(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, std::uint64_t b) noexcept
+{
+	unsigned long long high = 0;
+	unsigned char carry = 0;
+	unsigned char overflow = 0;
+
+	for (bigint::size_type i = 0; i < size * 2; i += 2)
 	{
-		const bool this_zero = zero();
-		const bool integer_zero = integer.zero();
+		unsigned long long low;
+		const unsigned long long previous = high;
 
-		if (!this_zero && !integer_zero) return sign_ < integer.sign_;
-		else if (this_zero && !integer_zero) return integer.sign_;
-		else if (!this_zero && integer_zero) return !sign_;
-		else return true;
+		low = _mulx_u64(load_limb(a + i), b, &high);
+		carry = _addcarryx_u64(carry, low, previous, &low);
+		overflow = _addcarryx_u64(overflow, low, load_limb(result + i), &low);
+		store_limb(result + i, low);
 	}
 
-	const bigint* smaller;
-	const bigint* larger;
+	return high + carry + overflow;
+}
+#	else
+// Loops count a negative index up to zero with lea and jrcxz, which leave CF and OF untouched.
+unsigned char add_limbs(bigint::block_type* result, const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size, unsigned char carry) noexcept
+{
+	std::uint64_t flag = carry;
+	std::uint64_t index = 0 - static_cast<std::uint64_t>(size);
+	std::uint64_t temp;
+
+	__asm__ volatile(
+		"add $-1, %[flag]\n\t"
+		"1:\n\t"
+		"mov (%[a],%[index],8), %[temp]\n\t"
+		"adc (%[b],%[index],8), %[temp]\n\t"
+		"mov %[temp], (%[result],%[index],8)\n\t"
+		"lea 1(%[index]), %[index]\n\t"
+		"jrcxz 2f\n\t"
+		"jmp 1b\n"
+		"2:\n\t"
+		"mov $0, %k[flag]\n\t"
+		"setc %b[flag]"
+		: [flag] "+&r"(flag), [index] "+&c"(index), [temp] "=&r"(temp)
+		: [result] "r"(result + size * 2), [a] "r"(a + size * 2), [b] "r"(b + size * 2)
+		: "cc", "memory");
+
+	return static_cast<unsigned char>(flag);
+}
+unsigned char sub_limbs(bigint::block_type* result, const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size, unsigned char borrow) noexcept
+{
+	std::uint64_t flag = borrow;
+	std::uint64_t index = 0 - static_cast<std::uint64_t>(size);
+	std::uint64_t temp;
+
+	__asm__ volatile(
+		"add $-1, %[flag]\n\t"
+		"1:\n\t"
+		"mov (%[a],%[index],8), %[temp]\n\t"
+		"sbb (%[b],%[index],8), %[temp]\n\t"
+		"mov %[temp], (%[result],%[index],8)\n\t"
+		"lea 1(%[index]), %[index]\n\t"
+		"jrcxz 2f\n\t"
+		"jmp 1b\n"
+		"2:\n\t"
+		"mov $0, %k[flag]\n\t"
+		"setc %b[flag]"
+		: [flag] "+&r"(flag), [index] "+&c"(index), [temp] "=&r"(temp)
+		: [result] "r"(result + size * 2), [a] "r"(a + size * 2), [b] "r"(b + size * 2)
+		: "cc", "memory");
+
+	return static_cast<unsigned char>(flag);
+}
+std::uint64_t mul_1_limbs(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, std::uint64_t b) noexcept
+{
+	std::uint64_t index = 0 - static_cast<std::uint64_t>(size);
+	std::uint64_t high, low, next;
+
+	__asm__ volatile(
+		"xor %k[high], %k[high]\n\t"
+		"1:\n\t"
+		"mulx (%[a],%[index],8), %[low], %[next]\n\t"
+		"adcx %[high], %[low]\n\t"
+		"mov %[low], (%[result],%[index],8)\n\t"
+		"mov %[next], %[high]\n\t"
+		"lea 1(%[index]), %[index]\n\t"
+		"jrcxz 2f\n\t"
+		"jmp 1b\n"
+		"2:\n\t"
+		"mov $0, %k[low]\n\t"
+		"adcx %[low], %[high]"
+		: [high] "=&r"(high), [low] "=&r"(low), [next] "=&r"(next), [index] "+&c"(index)
+		: [result] "r"(result + size * 2), [a] "r"(a + size * 2), "d"(b)
+		: "cc", "memory");
+
+	return high;
+}
+// Two carry chains: adcx carries the high halves of the products, adox the existing result.
+std::uint64_t addmul_1_limbs(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, std::uint64_t b) noexcept
+{
+	std::uint64_t index = 0 - static_cast<std::uint64_t>(size);
+	std::uint64_t high, low, next;
+
+	__asm__ volatile(
+		"xor %k[high], %k[high]\n\t"
+		"1:\n\t"
+		"mulx (%[a],%[index],8), %[low], %[next]\n\t"
+		"adcx %[high], %[low]\n\t"
+		"adox (%[result],%[index],8), %[low]\n\t"
+		"mov %[low], (%[result],%[index],8)\n\t"
+		"mov %[next], %[high]\n\t"
+		"lea 1(%[index]), %[index]\n\t"
+		"jrcxz 2f\n\t"
+		"jmp 1b\n"
+		"2:\n\t"
+		"mov $0, %k[low]\n\t"
+		"adcx %[low], %[high]\n\t"
+		"adox %[low], %[high]"
+		: [high] "=&r"(high), [low] "=&r"(low), [next] "=&r"(next), [index] "+&c"(index)
+		: [result] "r"(result + size * 2), [a] "r"(a + size * 2), "d"(b)
+		: "cc", "memory");
+
+	return high;
+}
+#	endif
 
-	if (capacity_ >= integer.capacity_)
+bigint::block_type add_n_adx(bigint::block_type* result, const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size, bigint::block_type carry) noexcept
+{
+	if (size >= 2)
 	{
-		larger = this;
-		smaller = &integer;
+		carry = add_limbs(result, a, b, size / 2, static_cast<unsigned char>(carry));
 	}
-	else
+
+	return size % 2 ? add_n_generic(result + size - 1, a + size - 1, b + size - 1, 1, carry) : carry;
+}
+bigint::block_type sub_n_adx(bigint::block_type* result, const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size, bigint::block_type borrow) noexcept
+{
+	if (size >= 2)
 	{
-		larger = &integer;
-		smaller = this;
+		borrow = sub_limbs(result, a, b, size / 2, static_cast<unsigned char>(borrow));
 	}
 
-	const size_type limit = smaller->capacity_;
+	return size % 2 ? sub_n_generic(result + size - 1, a + size - 1, b + size - 1, 1, borrow) : borrow;
+}
+bigint::block_type mul_1_adx(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, bigint::block_type b) noexcept
+{
+	if (size < 2) return mul_1_generic(result, a, size, b);
 
-	bool result = false;
+	const std::uint64_t carry = mul_1_limbs(result, a, size / 2, b) + (size % 2 ? static_cast<std::uint64_t>(a[size - 1]) * b : 0);
 
-	for (size_type i = larger->capacity_ - 1; i >= limit; --i)
+	if (size % 2)
 	{
-		if (larger->data_[i])
-		{
-			result = larger == this;
-			goto exit;
-		}
+		result[size - 1] = static_cast<bigint::block_type>(carry);
 	}
 
-	for (size_type i = limit - 1; i >= 0; --i)
+	return static_cast<bigint::block_type>(size % 2 ? carry >> 32 : carry);
+}
+bigint::block_type addmul_1_adx(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, bigint::block_type b) noexcept
+{
+	if (size < 2) return addmul_1_generic(result, a, size, b);
+
+	const std::uint64_t carry = addmul_1_limbs(result, a, size / 2, b) + (size % 2 ? static_cast<std::uint64_t>(a[size - 1]) * b + result[size - 1] : 0);
+
+	if (size % 2)
 	{
-		if (data_[i] > integer.data_[i])
-		{
-			result = true;
-			goto exit;
-		}
-		else if (data_[i] < integer.data_[i])
-		{
-			result = false;
-			goto exit;
-		}
-		else if (i == 0)
-		{
-			return true;
-		}
+		result[size - 1] = static_cast<bigint::block_type>(carry);
 	}
 
-exit:
-	return sign_ ? !result : result;
+	return static_cast<bigint::block_type>(size % 2 ? carry >> 32 : carry);
 }
-bool bigint::operator<(const bigint& integer) const noexcept
+// Multiplies the even-sized low parts limb by limb, then adds the odd top blocks as single rows.
+void mul_basecase_adx(bigint::block_type* result, const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size) noexcept
 {
-	if (!capacity_)
-	{
-		if (!integer.capacity_ || integer.zero()) return false;
-		else return !integer.sign_;
-	}
-	else if (!integer.capacity_)
+	const bigint::size_type a_even = a_size & ~static_cast<bigint::size_type>(1);
+	const bigint::size_type b_even = b_size & ~static_cast<bigint::size_type>(1);
+
+	if (!a_even || !b_even)
 	{
-		if (zero()) return false;
-		else return sign_;
+		mul_basecase_generic(result, a, a_size, b, b_size);
+		return;
 	}
-	else if (sign_ != integer.sign_)
-	{
-		const bool this_zero = zero();
-		const bool integer_zero = integer.zero();
 
-		if (!this_zero && !integer_zero) return sign_ > integer.sign_;
-		else if (this_zero && !integer_zero) return !integer.sign_;
-		else if (!this_zero && integer_zero) return sign_;
-		else return false;
+	store_limb(result + a_even, mul_1_limbs(result, a, a_even / 2, load_limb(b)));
+
+	for (bigint::size_type i = 2; i < b_even; i += 2)
+	{
+		store_limb(result + a_even + i, addmul_1_limbs(result + i, a, a_even / 2, load_limb(b + i)));
 	}
 
-	const bigint* smaller;
-	const bigint* larger;
+	std::fill(result + a_even + b_even, result + a_size + b_size, 0);
 
-	if (capacity_ >= integer.capacity_)
+	if (b_size % 2)
 	{
-		larger = this;
-		smaller = &integer;
+		result[a_even + b_even] = addmul_1_generic(result + b_even, a, a_even, b[b_even]);
+	}
+	if (a_size % 2)
+	{
+		result[a_size + b_size - 1] = addmul_1_generic(result + a_even, b, b_size, a[a_even]);
+	}
+}
+
+unsigned highest_bit(unsigned mask) noexcept
+{
+#	ifdef _MSC_VER
+	unsigned long index;
+
+	_BitScanReverse(&index, mask);
+
+	return static_cast<unsigned>(index);
+#	else
+	return 31 - static_cast<unsigned>(__builtin_clz(mask));
+#	endif
+}
+
+// result may equal a or lie above it.
+// The zero-masked shifts are the plain ones with a zero rather than an undefined merge source, which GCC warns about.
+_BIGNUM_TARGET("avx512f") bigint::block_type lshift_avx512(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, unsigned shift) noexcept
+{
+	const bigint::block_type out = a[size - 1] >> (32 - shift);
+	const __m128i left = _mm_cvtsi32_si128(static_cast<int>(shift));
+	const __m128i right = _mm_cvtsi32_si128(static_cast<int>(32 - shift));
+	bigint::size_type i = size;
+
+	while (i >= 17)
+	{
+		i -= 16;
+
+		const __m512i high = _mm512_loadu_si512(a + i);
+		const __m512i low = _mm512_loadu_si512(a + i - 1);
+
+		_mm512_storeu_si512(result + i, _mm512_or_si512(_mm512_maskz_sll_epi32(0xFFFF, high, left), _mm512_maskz_srl_epi32(0xFFFF, low, right)));
+	}
+
+	lshift_generic(result, a, i, shift);
+
+	return out;
+}
+// result may equal a or lie below it.
+_BIGNUM_TARGET("avx512f") bigint::block_type rshift_avx512(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, unsigned shift) noexcept
+{
+	const bigint::block_type out = a[0] << (32 - shift);
+	const __m128i left = _mm_cvtsi32_si128(static_cast<int>(32 - shift));
+	const __m128i right = _mm_cvtsi32_si128(static_cast<int>(shift));
+	bigint::size_type i = 0;
+
+	for (; i + 17 <= size; i += 16)
+	{
+		const __m512i low = _mm512_loadu_si512(a + i);
+		const __m512i high = _mm512_loadu_si512(a + i + 1);
+
+		_mm512_storeu_si512(result + i, _mm512_or_si512(_mm512_maskz_srl_epi32(0xFFFF, low, right), _mm512_maskz_sll_epi32(0xFFFF, high, left)));
+	}
+
+	rshift_generic(result + i, a + i, size - i, shift);
+
+	return out;
+}
+_BIGNUM_TARGET("avx512f") int compare_n_avx512(const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size) noexcept
+{
+	while (size >= 16)
+	{
+		size -= 16;
+
+		const __mmask16 mask = _mm512_cmpneq_epu32_mask(_mm512_loadu_si512(a + size), _mm512_loadu_si512(b + size));
+
+		if (mask)
+		{
+			const bigint::size_type i = size + highest_bit(mask);
+
+			return a[i] > b[i] ? 1 : -1;
+		}
+	}
+
+	return compare_n_generic(a, b, size);
+}
+
+struct cpu_features
+{
+	bool adx;
+	bool bmi2;
+	bool avx512f;
+};
+
+cpu_features detect_cpu() noexcept
+{
+	cpu_features features = {};
+	unsigned registers[4] = {};
+	unsigned long long xcr0 = 0;
+
+#	ifdef _MSC_VER
+	int info[4];
+
+	__cpuid(info, 0);
+	if (info[0] < 7) return features;
+
+	__cpuid(info, 1);
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+
+	__cpuidex(info, 7, 0);
+	std::memcpy(registers, info, sizeof(registers));
+
+	if (osxsave)
+	{
+		xcr0 = _xgetbv(0);
+	}
+#	else
+	if (__get_cpuid_max(0, nullptr) < 7) return features;
+
+	__cpuid(1, registers[0], registers[1], registers[2], registers[3]);
+	const bool osxsave = (registers[2] & (1u << 27)) != 0;
+
+	__cpuid_count(7, 0, registers[0], registers[1], registers[2], registers[3]);
+
+	if (osxsave)
+	{
+		unsigned low, high;
+
+		__asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+		xcr0 = (static_cast<unsigned long long>(high) << 32) | low;
+	}
+#	endif
+
+	features.bmi2 = (registers[1] & (1u << 8)) != 0;
+	features.adx = (registers[1] & (1u << 19)) != 0;
+	// The OS has to save the opmask and all 512-bit registers.
+	features.avx512f = (registers[1] & (1u << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+
+	return features;
+}
+#endif
+
+struct kernel_table
+{
+	bigint::block_type(*add_n)(bigint::block_type*, const bigint::block_type*, const bigint::block_type*, bigint::size_type, bigint::block_type) noexcept;
+	bigint::block_type(*sub_n)(bigint::block_type*, const bigint::block_type*, const bigint::block_type*, bigint::size_type, bigint::block_type) noexcept;
+	bigint::block_type(*mul_1)(bigint::block_type*, const bigint::block_type*, bigint::size_type, bigint::block_type) noexcept;
+	bigint::block_type(*addmul_1)(bigint::block_type*, const bigint::block_type*, bigint::size_type, bigint::block_type) noexcept;
+	void(*mul_basecase)(bigint::block_type*, const bigint::block_type*, bigint::size_type, const bigint::block_type*, bigint::size_type) noexcept;
+	bigint::block_type(*lshift)(bigint::block_type*, const bigint::block_type*, bigint::size_type, unsigned) noexcept;
+	bigint::block_type(*rshift)(bigint::block_type*, const bigint::block_type*, bigint::size_type, unsigned) noexcept;
+	int(*compare_n)(const bigint::block_type*, const bigint::block_type*, bigint::size_type) noexcept;
+	const char* name;
+};
+
+// BIGNUM_KERNELS=generic forces the portable kernels.
+kernel_table select_kernels() noexcept
+{
+	kernel_table table =
+	{
+		add_n_generic, sub_n_generic, mul_1_generic, addmul_1_generic, mul_basecase_generic,
+		lshift_generic, rshift_generic, compare_n_generic, "generic",
+	};
+
+	const char* const request = std::getenv("BIGNUM_KERNELS");
+
+	if (request && std::strcmp(request, "generic") == 0) return table;
+
+#ifdef _BIGNUM_X86_64
+	const cpu_features features = detect_cpu();
+
+	if (features.adx && features.bmi2)
+	{
+		table.add_n = add_n_adx;
+		table.sub_n = sub_n_adx;
+		table.mul_1 = mul_1_adx;
+		table.addmul_1 = addmul_1_adx;
+		table.mul_basecase = mul_basecase_adx;
+		table.name = "adx";
+	}
+	if (features.avx512f)
+	{
+		table.lshift = lshift_avx512;
+		table.rshift = rshift_avx512;
+		table.compare_n = compare_n_avx512;
+		table.name = features.adx && features.bmi2 ? "adx+avx512" : "avx512";
+	}
+#endif
+
+	return table;
+}
+const kernel_table& kernels() noexcept
+{
+	static const kernel_table table = select_kernels();
+
+	return table;
+}
+
+bigint::block_type add_n(bigint::block_type* result, const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size, bigint::block_type carry) noexcept
+{
+	return kernels().add_n(result, a, b, size, carry);
+}
+bigint::block_type add_1(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, bigint::block_type carry) noexcept
+{
+	bigint::size_type i = 0;
+
+	for (; i < size && carry; ++i)
+	{
+		result[i] = a[i] + 1;
+		carry = result[i] == 0;
+	}
+
+	if (result != a)
+	{
+		std::copy(a + i, a + size, result + i);
+	}
+
+	return carry;
+}
+bigint::block_type sub_n(bigint::block_type* result, const bigint::block_type* a, const bigint::block_type* b, bigint::size_type size, bigint::block_type borrow) noexcept
+{
+	return kernels().sub_n(result, a, b, size, borrow);
+}
+bigint::block_type sub_1(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, bigint::block_type borrow) noexcept
+{
+	bigint::size_type i = 0;
+
+	for (; i < size && borrow; ++i)
+	{
+		borrow = a[i] == 0;
+		result[i] = a[i] - 1;
+	}
+
+	if (result != a)
+	{
+		std::copy(a + i, a + size, result + i);
+	}
+
+	return borrow;
+}
+bigint::block_type mul_1(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, bigint::block_type b) noexcept
+{
+	return kernels().mul_1(result, a, size, b);
+}
+bigint::block_type addmul_1(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, bigint::block_type b) noexcept
+{
+	return kernels().addmul_1(result, a, size, b);
+}
+// result has a_size + b_size blocks and must not overlap a or b.
+void mul_basecase(bigint::block_type* result, const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size) noexcept
+{
+	kernels().mul_basecase(result, a, a_size, b, b_size);
+}
+// 0 < shift < 32 and size > 0. Returns the bits shifted out.
+bigint::block_type lshift(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, unsigned shift) noexcept
+{
+	return kernels().lshift(result, a, size, shift);
+}
+bigint::block_type rshift(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, unsigned shift) noexcept
+{
+	return kernels().rshift(result, a, size, shift);
+}
+
+int compare_unsigned(const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size) noexcept
+{
+	a_size = used_size(a, a_size);
+	b_size = used_size(b, b_size);
+
+	if (a_size != b_size) return a_size > b_size ? 1 : -1;
+
+	return kernels().compare_n(a, b, a_size);
+}
+int compare(const bigint_view& a, const bigint_view& b) noexcept
+{
+	const bool a_zero = a.zero();
+	const bool b_zero = b.zero();
+
+	if (a_zero || b_zero)
+	{
+		if (a_zero && b_zero) return 0;
+		else if (a_zero) return b.sign() ? 1 : -1;
+		else return a.sign() ? -1 : 1;
+	}
+	else if (a.sign() != b.sign()) return a.sign() ? -1 : 1;
+
+	_BIGNUM_STATS_OPERATION(compare, std::max(a.capacity(), b.capacity()));
+
+	const int result = compare_unsigned(a.data(), a.capacity(), b.data(), b.capacity());
+
+	return a.sign() ? -result : result;
+}
+
+// a_size >= b_size. result may alias a or b.
+bigint::block_type add_blocks(bigint::block_type* result, const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size) noexcept
+{
+	return add_1(result + b_size, a + b_size, a_size - b_size, add_n(result, a, b, b_size, 0));
+}
+// a_size >= b_size. result may alias a or b.
+bigint::block_type sub_blocks(bigint::block_type* result, const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size) noexcept
+{
+	return sub_1(result + b_size, a + b_size, a_size - b_size, sub_n(result, a, b, b_size, 0));
+}
+
+bigint::block_type div_1(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, bigint::block_type divisor) noexcept
+{
+	std::uint64_t remainder = 0;
+
+	for (bigint::size_type i = size; i-- > 0;)
+	{
+		const std::uint64_t dividend = (remainder << 32) | a[i];
+
+		result[i] = static_cast<bigint::block_type>(dividend / divisor);
+		remainder = dividend % divisor;
+	}
+
+	return static_cast<bigint::block_type>(remainder);
+}
+
+struct threshold_state
+{
+	std::atomic<bigint_thresholds::size_type> karatsuba;
+	std::atomic<bigint_thresholds::size_type> toom3;
+
+	threshold_state() noexcept;
+};
+
+// BIGNUM_THRESHOLDS names a config written by bignum-tune. It is ignored if it cannot be read.
+threshold_state::threshold_state() noexcept
+{
+	bigint_thresholds thresholds = bigint_thresholds::defaults();
+	const char* const path = std::getenv("BIGNUM_THRESHOLDS");
+
+	if (path)
+	{
+		try
+		{
+			thresholds = bigint_thresholds::load(path);
+		}
+		catch (...)
+		{}
+	}
+
+	karatsuba.store(thresholds.karatsuba, std::memory_order_relaxed);
+	toom3.store(thresholds.toom3, std::memory_order_relaxed);
+}
+
+threshold_state& get_thresholds() noexcept
+{
+	static threshold_state state;
+
+	return state;
+}
+
+// Writes |a - b| to result[0, size), size >= a_size, b_size. Returns whether a < b.
+bool abs_sub(bigint::block_type* result, const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size, bigint::size_type size) noexcept
+{
+	a_size = used_size(a, a_size);
+	b_size = used_size(b, b_size);
+
+	const bool less = compare_unsigned(a, a_size, b, b_size) < 0;
+
+	if (less)
+	{
+		std::swap(a, b);
+		std::swap(a_size, b_size);
+	}
+
+	sub_blocks(result, a, a_size, b, b_size);
+	std::fill(result + a_size, result + size, 0);
+
+	return less;
+}
+
+// A multiplication whose larger operand has size blocks needs at most this many blocks of scratch.
+bigint::size_type karatsuba_scratch(bigint::size_type size) noexcept
+{
+	return size * 8 + 16;
+}
+// a_size >= b_size > 0. result has a_size + b_size blocks and must not overlap a, b or scratch.
+void karatsuba(bigint::block_type* result, const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size,
+	bigint::block_type* scratch, bigint::size_type threshold) noexcept
+{
+	if (b_size < threshold)
+	{
+		mul_basecase(result, a, a_size, b, b_size);
+		return;
+	}
+
+	const bigint::size_type m = (a_size + 1) / 2;
+
+	if (b_size <= m)
+	{
+		// Unbalanced: multiply b_size-sized chunks of a and add them in.
+		bigint::block_type* const product = scratch;
+
+		karatsuba(result, a, b_size, b, b_size, scratch + b_size * 2, threshold);
+		std::fill(result + b_size * 2, result + a_size + b_size, 0);
+
+		for (bigint::size_type i = b_size; i < a_size; i += b_size)
+		{
+			const bigint::size_type chunk = std::min(b_size, a_size - i);
+
+			karatsuba(product, b, b_size, a + i, chunk, scratch + b_size * 2, threshold);
+			add_blocks(result + i, result + i, a_size + b_size - i, product, chunk + b_size);
+		}
+
+		return;
+	}
+
+	// a = a1 * B^m + a0 and b = b1 * B^m + b0. The middle term is a0b0 + a1b1 + (a0 - a1)(b1 - b0).
+	const bigint::size_type high_size = a_size + b_size - m * 2;
+	bigint::block_type* const a_difference = scratch;
+	bigint::block_type* const b_difference = scratch + m;
+	bigint::block_type* const product = scratch + m * 2;
+	bigint::block_type* const middle = scratch + m * 4;
+
+	karatsuba(result, a, m, b, m, scratch, threshold);
+	karatsuba(result + m * 2, a + m, a_size - m, b + m, b_size - m, scratch, threshold);
+
+	const bool negative = abs_sub(a_difference, a, m, a + m, a_size - m, m) != abs_sub(b_difference, b + m, b_size - m, b, m, m);
+
+	karatsuba(product, a_difference, m, b_difference, m, middle, threshold);
+
+	middle[m * 2] = add_blocks(middle, result, m * 2, result + m * 2, high_size);
+
+	if (negative)
+	{
+		sub_blocks(middle, middle, m * 2 + 1, product, m * 2);
+	}
+	else
+	{
+		add_blocks(middle, middle, m * 2 + 1, product, m * 2);
+	}
+
+	add_blocks(result + m, result + m, a_size + b_size - m, middle, used_size(middle, m * 2 + 1));
+}
+
+void toom3_divide_3(bigint& integer) noexcept
+{
+	div_1(integer.data(), integer.data(), integer.capacity(), 3);
+}
+bigint toom3_part(const bigint::block_type* data, bigint::size_type size, bigint::size_type begin, bigint::size_type length)
+{
+	return begin < size ? bigint(bigint_view(data + begin, std::min(length, size - begin), false)) : bigint();
+}
+// Evaluates at 0, 1, -1, -2 and infinity and interpolates with Bodrato's sequence. a_size >= b_size, 2 * b_size > a_size.
+void toom3(bigint::block_type* result, const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size)
+{
+	const bigint::size_type k = (a_size + 2) / 3;
+	const bigint a0 = toom3_part(a, a_size, 0, k), a1 = toom3_part(a, a_size, k, k), a2 = toom3_part(a, a_size, k * 2, k);
+	const bigint b0 = toom3_part(b, b_size, 0, k), b1 = toom3_part(b, b_size, k, k), b2 = toom3_part(b, b_size, k * 2, k);
+
+	bigint a_sum = a0 + a2;
+	bigint b_sum = b0 + b2;
+	const bigint a_minus_1 = a_sum - a1;
+	const bigint b_minus_1 = b_sum - b1;
+	const bigint a_minus_2 = ((a_minus_1 + a2) << 1) - a0;
+	const bigint b_minus_2 = ((b_minus_1 + b2) << 1) - b0;
+
+	a_sum += a1;
+	b_sum += b1;
+
+	const bigint r0 = a0 * b0;
+	bigint r1 = a_sum * b_sum;
+	const bigint r_minus_1 = a_minus_1 * b_minus_1;
+	bigint r3 = a_minus_2 * b_minus_2;
+	const bigint r4 = a2 * b2;
+
+	r3 -= r1;
+	toom3_divide_3(r3);
+	r1 -= r_minus_1;
+	r1 >>= 1;
+
+	bigint r2 = r_minus_1 - r0;
+
+	r3 = r2 - r3;
+	r3 >>= 1;
+	r3 += r4 << 1;
+	r2 += r1;
+	r2 -= r4;
+	r1 -= r3;
+
+	const bigint* const coefficients[] = { &r0, &r1, &r2, &r3, &r4 };
+
+	std::fill(result, result + a_size + b_size, 0);
+
+	for (bigint::size_type i = 0; i < 5; ++i)
+	{
+		const bigint::size_type offset = k * i;
+		const bigint::size_type size = used_size(coefficients[i]->data(), coefficients[i]->capacity());
+
+		if (size)
+		{
+			add_blocks(result + offset, result + offset, a_size + b_size - offset, coefficients[i]->data(), size);
+		}
+	}
+}
+// a_size >= b_size > 0. result has a_size + b_size blocks and must not overlap a or b.
+void multiply(bigint::block_type* result, const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size)
+{
+	threshold_state& thresholds = get_thresholds();
+	const bigint::size_type karatsuba_threshold = thresholds.karatsuba.load(std::memory_order_relaxed);
+	const bigint::size_type toom3_threshold = thresholds.toom3.load(std::memory_order_relaxed);
+
+	if (b_size < std::min(karatsuba_threshold, toom3_threshold))
+	{
+		mul_basecase(result, a, a_size, b, b_size);
+	}
+	else if (b_size < toom3_threshold)
+	{
+		const std::unique_ptr<bigint::block_type[]> scratch(new bigint::block_type[karatsuba_scratch(a_size)]);
+
+		karatsuba(result, a, a_size, b, b_size, scratch.get(), karatsuba_threshold);
+	}
+	else if (b_size * 2 <= a_size)
+	{
+		std::vector<bigint::block_type> product(b_size * 2);
+
+		multiply(result, a, b_size, b, b_size);
+		std::fill(result + b_size * 2, result + a_size + b_size, 0);
+
+		for (bigint::size_type i = b_size; i < a_size; i += b_size)
+		{
+			const bigint::size_type chunk = std::min(b_size, a_size - i);
+
+			multiply(product.data(), b, b_size, a + i, chunk);
+			add_blocks(result + i, result + i, a_size + b_size - i, product.data(), chunk + b_size);
+		}
+	}
+	else
+	{
+		toom3(result, a, a_size, b, b_size);
+	}
+}
+
+bigint::block_type submul_1(bigint::block_type* result, const bigint::block_type* a, bigint::size_type size, bigint::block_type b) noexcept
+{
+	std::uint64_t carry = 0;
+
+	for (bigint::size_type i = 0; i < size; ++i)
+	{
+		const std::uint64_t product = static_cast<std::uint64_t>(a[i]) * b + carry;
+		const bigint::block_type low = static_cast<bigint::block_type>(product);
+
+		carry = (product >> 32) + (result[i] < low);
+		result[i] -= low;
+	}
+
+	return static_cast<bigint::block_type>(carry);
+}
+unsigned leading_zeros(bigint::block_type block) noexcept
+{
+	unsigned count = 0;
+
+	for (; !(block & 0x80000000); block <<= 1)
+	{
+		++count;
+	}
+
+	return count;
+}
+// Knuth's algorithm D. a_size >= b_size > 0 and b[b_size - 1] != 0.
+// quotient has a_size - b_size + 1 blocks and remainder has b_size blocks.
+void divide(bigint::block_type* quotient, bigint::block_type* remainder, const bigint::block_type* a, bigint::size_type a_size, const bigint::block_type* b, bigint::size_type b_size)
+{
+	if (b_size == 1)
+	{
+		remainder[0] = div_1(quotient, a, a_size, b[0]);
+		return;
+	}
+
+	const unsigned shift = leading_zeros(b[b_size - 1]);
+	std::vector<bigint::block_type> u(a_size + 1);
+	std::vector<bigint::block_type> v(b_size);
+
+	if (shift)
+	{
+		lshift(v.data(), b, b_size, shift);
+		u[a_size] = lshift(u.data(), a, a_size, shift);
+	}
+	else
+	{
+		std::copy(b, b + b_size, v.begin());
+		std::copy(a, a + a_size, u.begin());
+	}
+
+	const std::uint64_t top = v[b_size - 1];
+	const std::uint64_t next = v[b_size - 2];
+
+	for (bigint::size_type j = a_size - b_size + 1; j-- > 0;)
+	{
+		const std::uint64_t numerator = (static_cast<std::uint64_t>(u[j + b_size]) << 32) | u[j + b_size - 1];
+		std::uint64_t estimate = numerator / top;
+		std::uint64_t rest = numerator % top;
+
+		while (estimate > 0xFFFFFFFF || estimate * next > ((rest << 32) | u[j + b_size - 2]))
+		{
+			--estimate;
+
+			if ((rest += top) > 0xFFFFFFFF) break;
+		}
+
+		const bigint::block_type borrow = submul_1(u.data() + j, v.data(), b_size, static_cast<bigint::block_type>(estimate));
+		const bigint::block_type head = u[j + b_size];
+
+		u[j + b_size] = head - borrow;
+
+		if (head < borrow)
+		{
+			--estimate;
+			u[j + b_size] += add_n(u.data() + j, u.data() + j, v.data(), b_size, 0);
+		}
+
+		quotient[j] = static_cast<bigint::block_type>(estimate);
+	}
+
+	if (shift)
+	{
+		rshift(remainder, u.data(), b_size, shift);
+	}
+	else
+	{
+		std::copy(u.begin(), u.begin() + b_size, remainder);
+	}
+}
+
+bigint::size_type bit_length(const bigint_view& integer) noexcept
+{
+	const bigint::size_type size = used_size(integer.data(), integer.capacity());
+
+	return size ? size * 32 - leading_zeros(integer.data()[size - 1]) : 0;
+}
+bigint::size_type trailing_zeros(const bigint_view& integer) noexcept
+{
+	const bigint::size_type size = used_size(integer.data(), integer.capacity());
+
+	for (bigint::size_type i = 0; i < size; ++i)
+	{
+		if (const bigint::block_type block = integer.data()[i])
+		{
+			bigint::size_type count = i * 32;
+
+			for (bigint::block_type bit = block; !(bit & 1); bit >>= 1)
+			{
+				++count;
+			}
+
+			return count;
+		}
+	}
+
+	return 0;
+}
+bool test_bit(const bigint_view& integer, bigint::size_type index) noexcept
+{
+	return index / 32 < integer.capacity() && (integer.data()[index / 32] >> (index % 32) & 1);
+}
+// Whether any of the bits below index are set.
+bool test_bits(const bigint_view& integer, bigint::size_type index) noexcept
+{
+	const bigint::size_type blocks = std::min(index / 32, integer.capacity());
+
+	if (used_size(integer.data(), blocks)) return true;
+
+	return blocks < integer.capacity() && index % 32 && (integer.data()[blocks] & ((bigint::block_type(1) << (index % 32)) - 1));
+}
+// Newton's iteration from above, on the magnitude of integer.
+bigint isqrt(const bigint_view& integer)
+{
+	const bigint::size_type bits = bit_length(integer);
+
+	if (!bits) return bigint();
+
+	const bigint_view magnitude(integer.data(), integer.capacity());
+	bigint root = bigint(1) << ((bits + 1) / 2);
+
+	for (;;)
+	{
+		bigint next = (root + magnitude / root) >> 1;
+
+		if (next >= root) break;
+
+		root = std::move(next);
+	}
+
+	return root;
+}
+bigint::block_type mod_1(const bigint::block_type* a, bigint::size_type size, bigint::block_type divisor) noexcept
+{
+	std::uint64_t remainder = 0;
+
+	for (bigint::size_type i = size; i-- > 0;)
+	{
+		remainder = ((remainder << 32) | a[i]) % divisor;
+	}
+
+	return static_cast<bigint::block_type>(remainder);
+}
+
+// Arithmetic modulo an odd n in Montgomery form, with R = 2^(32 * size).
+// Every operand must already be reduced below n. Results may alias operands.
+class montgomery final
+{
+public:
+	using block_type = bigint::block_type;
+	using size_type = bigint::size_type;
+
+public:
+	void reset(const block_type* modulus, size_type size);
+
+	void multiply(block_type* result, const block_type* a, const block_type* b);
+	void power(block_type* result, const block_type* base, const block_type* exponent, size_type exponent_size);
+	void add(block_type* result, const block_type* a, const block_type* b) noexcept;
+	void sub(block_type* result, const block_type* a, const block_type* b) noexcept;
+	void half(block_type* result, const block_type* a) noexcept;
+
+	void to_montgomery(block_type* result, const bigint_view& integer);
+	void from_montgomery(block_type* result, const block_type* a);
+
+	const block_type* modulus() const noexcept;
+	const block_type* one() const noexcept;
+	size_type size() const noexcept;
+
+private:
+	std::vector<block_type> modulus_;
+	std::vector<block_type> one_;
+	std::vector<block_type> square_;
+	std::vector<block_type> product_;
+	std::vector<block_type> carries_;
+	std::vector<block_type> unit_;
+	std::vector<block_type> table_;
+	std::vector<block_type> scratch_;
+	block_type inverse_ = 0;
+	size_type size_ = 0;
+	size_type karatsuba_threshold_ = 0;
+	size_type toom3_threshold_ = 0;
+};
+
+void montgomery::reset(const block_type* modulus, size_type size)
+{
+	modulus_.assign(modulus, modulus + size);
+	one_.assign(size, 0);
+	square_.assign(size, 0);
+	product_.assign(size * 2, 0);
+	carries_.assign(size, 0);
+	unit_.assign(size, 0);
+	table_.assign(size * 16, 0);
+	size_ = size;
+
+	// Products are formed once per step, so the Karatsuba scratch is kept rather than reallocated.
+	threshold_state& thresholds = get_thresholds();
+
+	karatsuba_threshold_ = thresholds.karatsuba.load(std::memory_order_relaxed);
+	toom3_threshold_ = thresholds.toom3.load(std::memory_order_relaxed);
+
+	if (size >= karatsuba_threshold_ && size < toom3_threshold_)
+	{
+		scratch_.resize(karatsuba_scratch(size));
+	}
+
+	unit_[0] = 1;
+
+	// Newton's iteration doubles the correct low bits of n^-1 mod 2^32 each step.
+	block_type inverse = modulus[0];
+
+	for (int i = 0; i < 4; ++i)
+	{
+		inverse *= 2 - modulus[0] * inverse;
+	}
+
+	inverse_ = 0 - inverse;
+
+	std::vector<block_type> power(size * 2 + 1, 0);
+	std::vector<block_type> quotient(size * 2 + 1);
+
+	power[size] = 1;
+	divide(quotient.data(), one_.data(), power.data(), size + 1, modulus, size);
+
+	power[size] = 0;
+	power[size * 2] = 1;
+	divide(quotient.data(), square_.data(), power.data(), size * 2 + 1, modulus, size);
+}
+void montgomery::multiply(block_type* result, const block_type* a, const block_type* b)
+{
+	block_type* const product = product_.data();
+
+	if (size_ < std::min(karatsuba_threshold_, toom3_threshold_))
+	{
+		mul_basecase(product, a, size_, b, size_);
+	}
+	else if (size_ < toom3_threshold_)
+	{
+		karatsuba(product, a, size_, b, size_, scratch_.data(), karatsuba_threshold_);
+	}
+	else
+	{
+		_BIGNUM_DETAILS::multiply(product, a, size_, b, size_);
+	}
+
+	// Each row's carry lands at or above block size_, which no later row reads,
+	// so the carries are gathered and added once at the end.
+	for (size_type i = 0; i < size_; ++i)
+	{
+		carries_[i] = addmul_1(product + i, modulus_.data(), size_, product[i] * inverse_);
+	}
+
+	const block_type carry = add_n(result, product + size_, carries_.data(), size_, 0);
+
+	if (carry || compare_unsigned(result, size_, modulus_.data(), size_) >= 0)
+	{
+		sub_n(result, result, modulus_.data(), size_, 0);
+	}
+}
+// Left-to-right with a fixed 4-bit window.
+void montgomery::power(block_type* result, const block_type* base, const block_type* exponent, size_type exponent_size)
+{
+	block_type* const table = table_.data();
+
+	std::copy(one_.begin(), one_.end(), table);
+	std::copy(base, base + size_, table + size_);
+
+	for (size_type i = 2; i < 16; ++i)
+	{
+		multiply(table + i * size_, table + (i - 1) * size_, base);
+	}
+
+	std::copy(one_.begin(), one_.end(), result);
+
+	bool started = false;
+
+	for (size_type i = exponent_size * 8; i-- > 0;)
+	{
+		const unsigned window = (exponent[i / 8] >> (i % 8 * 4)) & 0xF;
+
+		if (started)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				multiply(result, result, result);
+			}
+		}
+
+		if (window)
+		{
+			multiply(result, result, table + window * size_);
+			started = true;
+		}
+	}
+}
+void montgomery::add(block_type* result, const block_type* a, const block_type* b) noexcept
+{
+	const block_type carry = add_n(result, a, b, size_, 0);
+
+	if (carry || compare_unsigned(result, size_, modulus_.data(), size_) >= 0)
+	{
+		sub_n(result, result, modulus_.data(), size_, 0);
+	}
+}
+void montgomery::sub(block_type* result, const block_type* a, const block_type* b) noexcept
+{
+	if (sub_n(result, a, b, size_, 0))
+	{
+		add_n(result, result, modulus_.data(), size_, 0);
+	}
+}
+void montgomery::half(block_type* result, const block_type* a) noexcept
+{
+	block_type carry = 0;
+
+	if (a[0] & 1)
+	{
+		carry = add_n(result, a, modulus_.data(), size_, 0);
+		a = result;
+	}
+
+	rshift(result, a, size_, 1);
+	result[size_ - 1] |= carry << 31;
+}
+void montgomery::to_montgomery(block_type* result, const bigint_view& integer)
+{
+	bigint residue = bigint(integer) % bigint_view(modulus_.data(), size_);
+
+	if (residue.negative())
+	{
+		residue += bigint_view(modulus_.data(), size_);
+	}
+
+	residue.reserve(size_);
+
+	multiply(result, residue.data(), square_.data());
+}
+void montgomery::from_montgomery(block_type* result, const block_type* a)
+{
+	multiply(result, a, unit_.data());
+}
+const montgomery::block_type* montgomery::modulus() const noexcept
+{
+	return modulus_.data();
+}
+const montgomery::block_type* montgomery::one() const noexcept
+{
+	return one_.data();
+}
+montgomery::size_type montgomery::size() const noexcept
+{
+	return size_;
+}
+
+struct prime_group
+{
+	bigint::block_type product;
+	std::size_t begin;
+	std::size_t end;
+};
+struct small_primes
+{
+	static constexpr bigint::block_type limit = 4096;
+
+	std::vector<bigint::block_type> primes;
+	std::vector<prime_group> groups;
+
+	small_primes();
+};
+
+small_primes::small_primes()
+{
+	std::vector<bool> composite(limit, false);
+
+	for (bigint::block_type i = 2; i < limit; ++i)
+	{
+		if (composite[i]) continue;
+
+		primes.push_back(i);
+
+		for (bigint::block_type j = i * i; j < limit; j += i)
+		{
+			composite[j] = true;
+		}
+	}
+
+	// Groups primes so that one mod_1 pass over n tests several of them at once.
+	for (std::size_t i = 0; i < primes.size();)
+	{
+		prime_group group = { 1, i, i };
+
+		while (group.end < primes.size() && static_cast<std::uint64_t>(group.product) * primes[group.end] <= 0xFFFFFFFF)
+		{
+			group.product *= primes[group.end++];
+		}
+
+		groups.push_back(group);
+		i = group.end;
+	}
+}
+
+const small_primes& get_small_primes()
+{
+	static const small_primes primes;
+	return primes;
+}
+
+enum class trial_result
+{
+	prime,
+	composite,
+	unknown,
+};
+
+trial_result trial_division(const bigint::block_type* n, bigint::size_type size)
+{
+	const small_primes& table = get_small_primes();
+
+	if (size == 1 && n[0] < 2) return trial_result::composite;
+
+	for (const prime_group& group : table.groups)
+	{
+		const bigint::block_type remainder = mod_1(n, size, group.product);
+
+		for (std::size_t i = group.begin; i < group.end; ++i)
+		{
+			if (remainder % table.primes[i] == 0)
+			{
+				return size == 1 && n[0] == table.primes[i] ? trial_result::prime : trial_result::composite;
+			}
+		}
+	}
+
+	if (size == 1 && static_cast<std::uint64_t>(n[0]) < static_cast<std::uint64_t>(small_primes::limit) * small_primes::limit)
+	{
+		return trial_result::prime;
+	}
+
+	return trial_result::unknown;
+}
+
+// Jacobi symbol (a/n) for odd n.
+int jacobi(std::uint64_t a, std::uint64_t n) noexcept
+{
+	int result = 1;
+
+	a %= n;
+
+	while (a)
+	{
+		for (; !(a & 1); a >>= 1)
+		{
+			if ((n & 7) == 3 || (n & 7) == 5)
+			{
+				result = -result;
+			}
+		}
+
+		std::swap(a, n);
+
+		if ((a & 3) == 3 && (n & 3) == 3)
+		{
+			result = -result;
+		}
+
+		a %= n;
+	}
+
+	return n == 1 ? result : 0;
+}
+int jacobi(std::int64_t a, const bigint::block_type* n, bigint::size_type size) noexcept
+{
+	int result = 1;
+
+	if (a < 0)
+	{
+		a = -a;
+
+		if ((n[0] & 3) == 3)
+		{
+			result = -result;
+		}
+	}
+
+	std::uint64_t value = static_cast<std::uint64_t>(a);
+
+	for (; value && !(value & 1); value >>= 1)
+	{
+		if ((n[0] & 7) == 3 || (n[0] & 7) == 5)
+		{
+			result = -result;
+		}
+	}
+
+	if (value == 1) return result;
+	else if ((value & 3) == 3 && (n[0] & 3) == 3)
+	{
+		result = -result;
+	}
+
+	return result * jacobi(mod_1(n, size, static_cast<bigint::block_type>(value)), value);
+}
+
+bool perfect_square(const bigint::block_type* n, bigint::size_type size)
+{
+	const bigint_view integer(n, size);
+	const bigint root = isqrt(integer);
+
+	return root * root == integer;
+}
+
+// Uses a deterministic stream of bases so results do not vary between runs.
+std::uint64_t mix_base(std::uint64_t seed) noexcept
+{
+	seed += 0x9E3779B97F4A7C15;
+	seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9;
+	seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EB;
+	return seed ^ (seed >> 31);
+}
+
+bool miller_rabin(montgomery& context, const bigint_view& base, const std::vector<bigint::block_type>& exponent, bigint::size_type twos)
+{
+	const bigint::size_type size = context.size();
+
+	std::vector<bigint::block_type> x(size), minus_one(size), buffer(size);
+
+	context.sub(minus_one.data(), context.modulus(), context.one());
+	context.to_montgomery(buffer.data(), base);
+	context.power(x.data(), buffer.data(), exponent.data(), exponent.size());
+
+	const auto equal = [](const std::vector<bigint::block_type>& a, const bigint::block_type* b)
+	{
+		return std::equal(a.begin(), a.end(), b);
+	};
+
+	if (equal(x, context.one()) || equal(x, minus_one.data())) return true;
+
+	for (bigint::size_type i = 1; i < twos; ++i)
+	{
+		context.multiply(x.data(), x.data(), x.data());
+
+		if (equal(x, minus_one.data())) return true;
+		else if (equal(x, context.one())) return false;
+	}
+
+	return false;
+}
+
+// Strong Lucas test with Selfridge's parameters: the first D in 5, -7, 9, ...
+// with (D/n) = -1, P = 1 and Q = (1 - D) / 4.
+bool strong_lucas(montgomery& context, const bigint::block_type* n, bigint::size_type size)
+{
+	std::int64_t d = 5;
+
+	for (int i = 0;; ++i)
+	{
+		const int symbol = jacobi(d, n, size);
+
+		if (symbol == -1) break;
+		else if (symbol == 0) return false;
+		else if (i == 8 && perfect_square(n, size)) return false;
+
+		d = d > 0 ? -(d + 2) : -d + 2;
+	}
+
+	// n + 1 = k * 2^s with k odd.
+	std::vector<bigint::block_type> k(size + 1, 0);
+
+	k[size] = add_1(k.data(), n, size, 1);
+
+	const bigint::size_type k_size = used_size(k.data(), size + 1);
+	bigint::size_type twos = 0;
+
+	while (!(k[twos / 32] >> (twos % 32) & 1))
+	{
+		++twos;
+	}
+
+	const bigint shifted = bigint(bigint_view(k.data(), k_size)) >> twos;
+	const bigint::block_type* const exponent = shifted.data();
+	const bigint::size_type exponent_size = used_size(shifted.data(), shifted.capacity());
+
+	std::vector<bigint::block_type> u(size), v(size), q(size), qk(size), dm(size), t(size);
+
+	context.to_montgomery(q.data(), bigint((1 - d) / 4));
+	context.to_montgomery(dm.data(), bigint(d));
+	std::copy(context.one(), context.one() + size, u.begin());
+	std::copy(context.one(), context.one() + size, v.begin());
+	qk = q;
+
+	bigint::size_type top = exponent_size * 32 - leading_zeros(exponent[exponent_size - 1]) - 1;
+
+	while (top-- > 0)
+	{
+		// U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+		context.multiply(u.data(), u.data(), v.data());
+		context.multiply(v.data(), v.data(), v.data());
+		context.sub(v.data(), v.data(), qk.data());
+		context.sub(v.data(), v.data(), qk.data());
+		context.multiply(qk.data(), qk.data(), qk.data());
+
+		if (exponent[top / 32] >> (top % 32) & 1)
+		{
+			// U_k+1 = (P U_k + V_k) / 2, V_k+1 = (D U_k + P V_k) / 2
+			context.multiply(t.data(), dm.data(), u.data());
+			context.add(u.data(), u.data(), v.data());
+			context.half(u.data(), u.data());
+			context.add(v.data(), t.data(), v.data());
+			context.half(v.data(), v.data());
+			context.multiply(qk.data(), qk.data(), q.data());
+		}
+	}
+
+	const auto zero = [](const std::vector<bigint::block_type>& a)
+	{
+		return std::all_of(a.begin(), a.end(), [](bigint::block_type block) { return block == 0; });
+	};
+
+	if (zero(u) || zero(v)) return true;
+
+	for (bigint::size_type i = 1; i < twos; ++i)
+	{
+		context.multiply(v.data(), v.data(), v.data());
+		context.sub(v.data(), v.data(), qk.data());
+		context.sub(v.data(), v.data(), qk.data());
+
+		if (zero(v)) return true;
+
+		context.multiply(qk.data(), qk.data(), qk.data());
+	}
+
+	return false;
+}
+
+// Baillie-PSW: trial division, a base-2 strong probable prime test and a strong Lucas test,
+// followed by rounds extra Miller-Rabin tests with bases derived from n.
+bool probable_prime(const bigint_view& integer, unsigned rounds, montgomery& context)
+{
+	const bigint::size_type size = used_size(integer.data(), integer.capacity());
+
+	if (integer.sign() || !size) return false;
+
+	const bigint::block_type* const n = integer.data();
+
+	switch (trial_division(n, size))
+	{
+	case trial_result::prime: return true;
+	case trial_result::composite: return false;
+	default: break;
+	}
+
+	context.reset(n, size);
+
+	// n - 1 = d * 2^s with d odd.
+	bigint d = bigint(integer) - 1;
+	bigint::size_type twos = 0;
+
+	while (!(d.data()[twos / 32] >> (twos % 32) & 1))
+	{
+		++twos;
+	}
+
+	d >>= twos;
+
+	const std::vector<bigint::block_type> exponent(d.data(), d.data() + used_size(d.data(), d.capacity()));
+
+	if (!miller_rabin(context, bigint(2), exponent, twos)) return false;
+	else if (!strong_lucas(context, n, size)) return false;
+
+	const bigint range = bigint(integer) - 3;
+	std::uint64_t seed = static_cast<std::uint64_t>(n[0]) | static_cast<std::uint64_t>(n[size - 1]) << 32;
+
+	for (unsigned i = 0; i < rounds; ++i)
+	{
+		seed = mix_base(seed ^ i);
+
+		const bigint base = bigint(seed) % range + 2;
+
+		if (!miller_rabin(context, base, exponent, twos)) return false;
+	}
+
+	return true;
+}
+
+// Zero threads means one per hardware thread. Callers default to one, because starting threads costs
+// more than the small levels and windows they would share.
+unsigned thread_count(unsigned threads, std::size_t count) noexcept
+{
+	if (!threads)
+	{
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	return static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(count, 1)));
+}
+
+// Hands out indices in increasing order to threads workers. The first exception thrown is rethrown.
+void parallel_for(std::size_t count, unsigned threads, const std::function<void(std::size_t, unsigned)>& function)
+{
+	if (threads <= 1)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			function(i, 0);
+		}
+
+		return;
+	}
+
+	std::atomic<std::size_t> next(0);
+	std::exception_ptr error;
+	std::mutex error_mutex;
+	std::vector<std::thread> workers;
+
+	const auto work = [&](unsigned worker)
+	{
+		try
+		{
+			for (std::size_t i; (i = next++) < count;)
+			{
+				function(i, worker);
+			}
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> guard(error_mutex);
+
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+
+			next = count;
+		}
+	};
+
+	for (unsigned i = 1; i < threads; ++i)
+	{
+		workers.emplace_back(work, i);
+	}
+
+	work(0);
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+// Every accumulated block adds less than 2^32 to a limb, so a limb can absorb this many additions before it may overflow.
+constexpr bigint_accumulator::size_type accumulator_headroom = static_cast<bigint_accumulator::size_type>(1) << 30;
+
+std::atomic<std::uint64_t> concurrent_accumulator_id(1);
+
+struct concurrent_accumulator_cache
+{
+	std::uint64_t id;
+	void* shard;
+};
+
+thread_local concurrent_accumulator_cache concurrent_accumulator_caches[8] = {};
+
+// The bigint_concurrent_accumulator shards a thread owns, marked as abandoned for other threads to adopt when it exits.
+class concurrent_accumulator_owner final
+{
+public:
+	concurrent_accumulator_owner() = default;
+	concurrent_accumulator_owner(const concurrent_accumulator_owner&) = delete;
+	~concurrent_accumulator_owner()
+	{
+		for (const entry& owned : shards_)
+		{
+			owned.abandoned->store(true, std::memory_order_release);
+		}
+	}
+
+public:
+	concurrent_accumulator_owner& operator=(const concurrent_accumulator_owner&) = delete;
+
+public:
+	void* find(std::uint64_t id) const noexcept
+	{
+		for (const entry& owned : shards_)
+		{
+			if (owned.id == id) return owned.shard;
+		}
+
+		return nullptr;
+	}
+	void add(std::uint64_t id, void* shard, const std::shared_ptr<std::atomic<bool>>& abandoned)
+	{
+		// Flags nobody else holds belong to destroyed accumulators.
+		shards_.erase(std::remove_if(shards_.begin(), shards_.end(), [](const entry& owned)
+		{
+			return owned.abandoned.use_count() == 1;
+		}), shards_.end());
+		shards_.push_back({ id, shard, abandoned });
+	}
+
+private:
+	struct entry
+	{
+		std::uint64_t id;
+		void* shard;
+		std::shared_ptr<std::atomic<bool>> abandoned;
+	};
+
+	std::vector<entry> shards_;
+};
+
+concurrent_accumulator_owner& concurrent_accumulator_owners()
+{
+	thread_local concurrent_accumulator_owner owner;
+	return owner;
+}
+
+// Keeps the retired buffers of a bigint_concurrent_accumulator alive while a reader may still be looking at them.
+class concurrent_accumulator_reader final
+{
+public:
+	explicit concurrent_accumulator_reader(std::atomic<std::size_t>& readers) noexcept
+		: readers_(readers)
+	{
+		readers_.fetch_add(1, std::memory_order_seq_cst);
+	}
+	concurrent_accumulator_reader(const concurrent_accumulator_reader&) = delete;
+	~concurrent_accumulator_reader()
+	{
+		readers_.fetch_sub(1, std::memory_order_seq_cst);
+	}
+
+public:
+	concurrent_accumulator_reader& operator=(const concurrent_accumulator_reader&) = delete;
+
+private:
+	std::atomic<std::size_t>& readers_;
+};
+
+struct array_header
+{
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t byte_order;
+	std::uint64_t size;
+	std::uint64_t blocks;
+};
+
+static_assert(sizeof(array_header) == 32, "sizeof(array_header) != 32");
+
+constexpr char array_magic[8] = { 'B', 'I', 'G', 'N', 'U', 'M', 'A', 'R' };
+constexpr std::uint32_t array_version = 1;
+constexpr std::uint32_t array_byte_order = 0x01020304;
+constexpr std::uint64_t array_sign = static_cast<std::uint64_t>(1) << 63;
+
+void* map_file(const char* path, std::size_t& size)
+{
+#ifdef _WIN32
+	const HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("cannot open file");
+
+	LARGE_INTEGER file_size;
+
+	if (!GetFileSizeEx(file, &file_size))
+	{
+		CloseHandle(file);
+		throw std::runtime_error("cannot open file");
+	}
+	else if (!(size = static_cast<std::size_t>(file_size.QuadPart)))
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	CloseHandle(file);
+
+	if (!mapping) throw std::runtime_error("cannot map file");
+
+	void* const address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	CloseHandle(mapping);
+
+	if (!address) throw std::runtime_error("cannot map file");
+
+	return address;
+#else
+	const int file = open(path, O_RDONLY);
+
+	if (file < 0) throw std::runtime_error("cannot open file");
+
+	struct stat status;
+
+	if (fstat(file, &status) != 0)
+	{
+		close(file);
+		throw std::runtime_error("cannot open file");
+	}
+	else if (!(size = static_cast<std::size_t>(status.st_size)))
+	{
+		close(file);
+		return nullptr;
+	}
+
+	void* const address = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+
+	close(file);
+
+	if (address == MAP_FAILED) throw std::runtime_error("cannot map file");
+
+	return address;
+#endif
+}
+void unmap_file(void* address, std::size_t size) noexcept
+{
+	if (!address) return;
+
+#ifdef _WIN32
+	static_cast<void>(size);
+	UnmapViewOfFile(address);
+#else
+	munmap(address, size);
+#endif
+}
+
+// A tile of each operand and a product tile stay within L2, and tiles span whole pages.
+constexpr bigint::size_type file_tile = 4096;
+// Backing files grow in multiples of the Windows allocation granularity.
+constexpr std::size_t file_granularity = 65536;
+
+std::intptr_t create_temporary_file(const char* directory)
+{
+#ifdef _WIN32
+	char temporary_directory[MAX_PATH + 1];
+	char path[MAX_PATH + 1];
+
+	if (!directory)
+	{
+		if (!GetTempPathA(MAX_PATH + 1, temporary_directory)) throw std::runtime_error("cannot create temporary file");
+
+		directory = temporary_directory;
+	}
+
+	if (!GetTempFileNameA(directory, "bn", 0, path)) throw std::runtime_error("cannot create temporary file");
+
+	const HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		DeleteFileA(path);
+		throw std::runtime_error("cannot create temporary file");
+	}
+
+	return reinterpret_cast<std::intptr_t>(file);
+#else
+	if (!directory)
+	{
+		directory = std::getenv("TMPDIR");
+		directory = directory && *directory ? directory : "/tmp";
+	}
+
+	std::string path = directory;
+
+	path += "/bignum-XXXXXX";
+
+	const int file = mkstemp(&path[0]);
+
+	if (file < 0) throw std::runtime_error("cannot create temporary file");
+
+	unlink(path.c_str());
+
+	return file;
+#endif
+}
+void close_file(std::intptr_t file) noexcept
+{
+	if (file == -1) return;
+
+#ifdef _WIN32
+	CloseHandle(reinterpret_cast<HANDLE>(file));
+#else
+	close(static_cast<int>(file));
+#endif
+}
+void* map_temporary_file(std::intptr_t file, void* address, std::size_t old_size, std::size_t new_size)
+{
+#ifdef _WIN32
+	const HANDLE mapping = CreateFileMappingA(reinterpret_cast<HANDLE>(file), nullptr, PAGE_READWRITE,
+		static_cast<DWORD>(static_cast<std::uint64_t>(new_size) >> 32), static_cast<DWORD>(new_size & 0xFFFFFFFF), nullptr);
+
+	if (!mapping) throw std::runtime_error("cannot map file");
+
+	void* const new_address = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, new_size);
+
+	CloseHandle(mapping);
+
+	if (!new_address) throw std::runtime_error("cannot map file");
+#else
+	if (ftruncate(static_cast<int>(file), static_cast<off_t>(new_size)) != 0) throw std::runtime_error("cannot resize file");
+
+	void* const new_address = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, static_cast<int>(file), 0);
+
+	if (new_address == MAP_FAILED) throw std::runtime_error("cannot map file");
+
+	madvise(new_address, new_size, MADV_SEQUENTIAL);
+#endif
+
+	unmap_file(address, old_size);
+
+	return new_address;
+}
+void advise_willneed(const void* address, std::size_t size) noexcept
+{
+#ifdef _WIN32
+	static_cast<void>(address);
+	static_cast<void>(size);
+#else
+	static const std::uintptr_t page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+
+	const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(address) & ~(page - 1);
+	const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(address) + size;
+
+	if (size)
+	{
+		madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+	}
+#endif
+}
+
+// Bits [position, position + 32) of the magnitude of integer, with zeros outside it.
+bigint::block_type extract_bits(const bigint_view& integer, std::int64_t position) noexcept
+{
+	const std::int64_t index = position >= 0 ? position / 32 : -((31 - position) / 32);
+	const unsigned shift = static_cast<unsigned>(position - index * 32);
+
+	const auto block = [&integer](std::int64_t index) -> bigint::block_type
+	{
+		return index >= 0 && static_cast<std::uint64_t>(index) < integer.capacity() ? integer.data()[index] : 0;
+	};
+
+	return shift ? (block(index) >> shift) | (block(index + 1) << (32 - shift)) : block(index);
+}
+int compare_magnitude(const bigfloat& a, const bigfloat& b) noexcept
+{
+	const std::int64_t a_top = a.exponent() + static_cast<std::int64_t>(bit_length(a.mantissa()));
+	const std::int64_t b_top = b.exponent() + static_cast<std::int64_t>(bit_length(b.mantissa()));
+
+	if (a.zero() || b.zero()) return b.zero() - a.zero();
+	else if (a_top != b_top) return a_top < b_top ? -1 : 1;
+
+	const std::int64_t bottom = std::min(a.exponent(), b.exponent());
+
+	for (std::int64_t position = a_top - 32; position > bottom - 32; position -= 32)
+	{
+		const bigint::block_type a_bits = extract_bits(a.mantissa(), position - a.exponent());
+		const bigint::block_type b_bits = extract_bits(b.mantissa(), position - b.exponent());
+
+		if (a_bits != b_bits) return a_bits < b_bits ? -1 : 1;
+	}
+
+	return 0;
+}
+int compare(const bigfloat& a, const bigfloat& b) noexcept
+{
+	if (a.negative() != b.negative()) return a.negative() ? -1 : 1;
+
+	const int result = compare_magnitude(a, b);
+
+	return a.negative() ? -result : result;
+}
+
+// Whether the magnitude of integer is one.
+bool unit(const bigint_view& integer) noexcept
+{
+	return used_size(integer.data(), integer.capacity()) == 1 && integer.data()[0] == 1;
+}
+bigint cancel_gcd(const bigint_view& a, const bigint_view& b)
+{
+	return unit(a) || unit(b) ? bigint(1) : bigint::gcd(a, b);
+}
+bigint cancel(const bigint& integer, const bigint& divisor)
+{
+	return unit(divisor) ? integer : integer / divisor;
+}
+
+std::uint32_t power_mod(std::uint64_t base, std::uint32_t exponent, std::uint32_t modulus) noexcept
+{
+	std::uint64_t result = 1;
+
+	for (base %= modulus; exponent; exponent >>= 1)
+	{
+		if (exponent & 1)
+		{
+			result = result * base % modulus;
+		}
+
+		base = base * base % modulus;
+	}
+
+	return static_cast<std::uint32_t>(result);
+}
+// Miller-Rabin with bases 2, 7 and 61 is exact below 4759123141.
+bool word_prime(std::uint32_t n) noexcept
+{
+	if (n < 2 || !(n & 1)) return n == 2;
+
+	std::uint32_t odd = n - 1;
+	unsigned twos = 0;
+
+	for (; !(odd & 1); odd >>= 1)
+	{
+		++twos;
+	}
+
+	static const std::uint32_t bases[] = { 2, 7, 61 };
+
+	for (std::uint32_t base : bases)
+	{
+		if (base % n == 0) continue;
+
+		std::uint64_t x = power_mod(base, odd, n);
+
+		if (x == 1 || x == n - 1) continue;
+
+		unsigned i = 1;
+
+		for (; i < twos && x != n - 1; ++i)
+		{
+			x = x * x % n;
+		}
+
+		if (x != n - 1) return false;
+	}
+
+	return true;
+}
+// Montgomery reduction by 2^32 for a prime below 2^31, where inverse is -prime^-1 mod 2^32.
+inline std::uint32_t redc_word(std::uint64_t value, std::uint32_t prime, std::uint32_t inverse) noexcept
+{
+	const std::uint32_t factor = static_cast<std::uint32_t>(value) * inverse;
+	const std::uint32_t result = static_cast<std::uint32_t>((value + static_cast<std::uint64_t>(factor) * prime) >> 32);
+
+	return result >= prime ? result - prime : result;
+}
+
+// Bases at least this large convert through the product tree instead of per-prime division and Garner's algorithm.
+constexpr std::size_t rns_tree_threshold = 64;
+
+// Splits [0, size) into chunks for threads workers once there is enough work to share.
+void parallel_chunks(std::size_t size, unsigned threads, const std::function<void(std::size_t, std::size_t)>& function)
+{
+	constexpr std::size_t chunk = 1 << 12;
+
+	const std::size_t chunks = (size + chunk - 1) / chunk;
+
+	if (chunks <= 1)
+	{
+		function(0, size);
+		return;
+	}
+
+	parallel_for(chunks, thread_count(threads, chunks), [&](std::size_t index, unsigned)
+	{
+		function(index * chunk, std::min(size, (index + 1) * chunk));
+	});
+}
+
+_BIGNUM_DETAILS_END
+
+constexpr bool bigint_stats::enabled;
+constexpr std::size_t bigint_stats::sites;
+constexpr std::size_t bigint_stats::operations;
+constexpr std::size_t bigint_stats::buckets;
+
+bigint_stats bigint_stats::snapshot()
+{
+	bigint_stats stats;
+
+#ifdef _BIGNUM_STATS
+	_BIGNUM_DETAILS::stats_registry& registry = _BIGNUM_DETAILS::get_stats_registry();
+	std::lock_guard<std::mutex> guard(registry.mutex);
+
+	stats = _BIGNUM_DETAILS::collect_stats(registry);
+
+	for (std::size_t i = 0; i < sites; ++i)
+	{
+		stats.allocations[i] -= registry.baseline.allocations[i];
+		stats.reallocations[i] -= registry.baseline.reallocations[i];
+		stats.bytes[i] -= registry.baseline.bytes[i];
+	}
+	for (std::size_t i = 0; i < operations; ++i)
+	{
+		stats.calls[i] -= registry.baseline.calls[i];
+
+		for (std::size_t j = 0; j < buckets; ++j)
+		{
+			stats.sizes[i][j] -= registry.baseline.sizes[i][j];
+		}
+	}
+#endif
+
+	return stats;
+}
+void bigint_stats::reset()
+{
+#ifdef _BIGNUM_STATS
+	_BIGNUM_DETAILS::stats_registry& registry = _BIGNUM_DETAILS::get_stats_registry();
+	std::lock_guard<std::mutex> guard(registry.mutex);
+
+	registry.baseline = _BIGNUM_DETAILS::collect_stats(registry);
+#endif
+}
+
+const char* bigint_stats::name(site site) noexcept
+{
+	static const char* const names[sites] =
+	{
+		"construct", "copy", "assign", "reserve", "shrink", "add", "sub", "increment", "multiply", "divide", "shift", "from_bytes", "accumulator", "array",
+	};
+
+	return names[static_cast<std::size_t>(site)];
+}
+const char* bigint_stats::name(operation operation) noexcept
+{
+	static const char* const names[operations] =
+	{
+		"construct", "copy", "assign", "compare", "add", "sub", "increment", "multiply", "divide", "shift", "to_string", "from_bytes", "to_bytes", "accumulate",
+	};
+
+	return names[static_cast<std::size_t>(operation)];
+}
+
+bigint_thresholds bigint_thresholds::defaults() noexcept
+{
+	return { _BIGNUM_KARATSUBA_THRESHOLD, _BIGNUM_TOOM3_THRESHOLD };
+}
+bigint_thresholds bigint_thresholds::get() noexcept
+{
+	_BIGNUM_DETAILS::threshold_state& state = _BIGNUM_DETAILS::get_thresholds();
+
+	return { state.karatsuba.load(std::memory_order_relaxed), state.toom3.load(std::memory_order_relaxed) };
+}
+void bigint_thresholds::set(const bigint_thresholds& thresholds)
+{
+	if (thresholds.karatsuba < 2) throw std::invalid_argument("thresholds.karatsuba < 2");
+	else if (thresholds.toom3 < 3) throw std::invalid_argument("thresholds.toom3 < 3");
+
+	_BIGNUM_DETAILS::threshold_state& state = _BIGNUM_DETAILS::get_thresholds();
+
+	state.karatsuba.store(thresholds.karatsuba, std::memory_order_relaxed);
+	state.toom3.store(thresholds.toom3, std::memory_order_relaxed);
+}
+
+// One "name value" pair per line; '#' starts a comment. Missing names keep their defaults and unknown names are skipped.
+bigint_thresholds bigint_thresholds::load(const char* path)
+{
+	std::FILE* const file = std::fopen(path, "r");
+
+	if (!file) throw std::runtime_error("cannot open thresholds file");
+
+	bigint_thresholds thresholds = defaults();
+	char line[256];
+	bool valid = true;
+
+	while (valid && std::fgets(line, sizeof(line), file))
+	{
+		char name[64];
+		unsigned long long value;
+		const int fields = std::sscanf(line, " %63s %llu", name, &value);
+
+		if (fields <= 0 || name[0] == '#') continue;
+		else if (fields != 2)
+		{
+			valid = false;
+		}
+		else if (std::strcmp(name, "karatsuba") == 0)
+		{
+			thresholds.karatsuba = static_cast<size_type>(value);
+		}
+		else if (std::strcmp(name, "toom3") == 0)
+		{
+			thresholds.toom3 = static_cast<size_type>(value);
+		}
+	}
+
+	std::fclose(file);
+
+	if (!valid || thresholds.karatsuba < 2 || thresholds.toom3 < 3) throw std::runtime_error("invalid thresholds file");
+
+	return thresholds;
+}
+void bigint_thresholds::save(const char* path) const
+{
+	std::FILE* const file = std::fopen(path, "w");
+
+	if (!file) throw std::runtime_error("cannot open thresholds file");
+
+	const bool written = std::fprintf(file, "karatsuba %llu\ntoom3 %llu\n",
+		static_cast<unsigned long long>(karatsuba), static_cast<unsigned long long>(toom3)) > 0;
+
+	if (std::fclose(file) != 0 || !written) throw std::runtime_error("cannot write thresholds file");
+}
+
+bigint::bigint(std::int32_t integer)
+	: capacity_(integer == std::numeric_limits<std::int32_t>::min() ? 2 : 1)
+{
+	data_ = reinterpret_cast<block_type*>(std::calloc(capacity_, sizeof(block_type)));
+
+	if (!data_)
+	{
+		capacity_ = 0;
+		throw std::bad_alloc();
+	}
+
+	_BIGNUM_STATS_ALLOCATE(construct, sizeof(block_type) * capacity_);
+	_BIGNUM_STATS_OPERATION(construct, capacity_);
+
+	data_[0] = static_cast<block_type>(integer);
+
+	if (integer < 0)
+	{
+		sign_ = true;
+		if ((data_[0] = ~data_[0] + 1) == 0) // Overflow
+		{
+			data_[1] = 1;
+		}
+	}
+}
+bigint::bigint(std::uint32_t integer)
+	: capacity_(1)
+{
+	data_ = reinterpret_cast<block_type*>(std::calloc(1, sizeof(block_type)));
+
+	if (!data_)
+	{
+		capacity_ = 0;
+		throw std::bad_alloc();
+	}
+
+	_BIGNUM_STATS_ALLOCATE(construct, sizeof(block_type) * capacity_);
+	_BIGNUM_STATS_OPERATION(construct, capacity_);
+
+	*data_ = integer;
+}
+bigint::bigint(std::int64_t integer)
+	: capacity_(integer == std::numeric_limits<std::int32_t>::min() ? 3 : 2)
+{
+	data_ = reinterpret_cast<block_type*>(std::calloc(capacity_, sizeof(block_type)));
+
+	if (!data_)
+	{
+		capacity_ = 0;
+		throw std::bad_alloc();
+	}
+
+	_BIGNUM_STATS_ALLOCATE(construct, sizeof(block_type) * capacity_);
+	_BIGNUM_STATS_OPERATION(construct, capacity_);
+
+	data_[0] = static_cast<block_type>(static_cast<std::uint64_t>(integer) & 0xFFFFFFFF);
+	data_[1] = static_cast<block_type>(static_cast<std::uint64_t>(integer) >> 32);
+
+	if (integer < 0)
+	{
+		sign_ = true;
+		data_[1] = ~data_[1];
+		if ((data_[0] = ~data_[0] + 1) == 0) // Overflow
+		{
+			if ((data_[1] += 1) == 0) // Overflow
+			{
+				data_[2] = 1;
+			}
+		}
+	}
+}
+bigint::bigint(std::uint64_t integer)
+	: capacity_(2)
+{
+	data_ = reinterpret_cast<block_type*>(std::calloc(2, sizeof(block_type)));
+
+	if (!data_)
+	{
+		capacity_ = 0;
+		throw std::bad_alloc();
+	}
+
+	_BIGNUM_STATS_ALLOCATE(construct, sizeof(block_type) * capacity_);
+	_BIGNUM_STATS_OPERATION(construct, capacity_);
+
+	data_[0] = static_cast<block_type>(integer & 0xFFFFFFFF);
+	data_[1] = static_cast<block_type>(integer >> 32);
+}
+bigint::bigint(const bigint& integer)
+	: capacity_(integer.capacity_), sign_(integer.sign_)
+{
+	if (integer.capacity_)
+	{
+		data_ = reinterpret_cast<block_type*>(std::calloc(capacity_, sizeof(block_type)));
+
+		if (!data_)
+		{
+			capacity_ = 0;
+			sign_ = false;
+			throw std::bad_alloc();
+		}
+
+		std::copy(integer.data_, integer.data_ + integer.capacity_, data_);
+
+		_BIGNUM_STATS_ALLOCATE(copy, sizeof(block_type) * capacity_);
+	}
+
+	_BIGNUM_STATS_OPERATION(copy, capacity_);
+}
+bigint::bigint(const bigint& integer, size_type new_capacity)
+	: capacity_(new_capacity), sign_(integer.sign_)
+{
+	if (capacity_ < integer.capacity_)
+	{
+		capacity_ = 0;
+		sign_ = false;
+		throw std::invalid_argument("new_capacity < integer.capacity()");
+	}
+
+	data_ = reinterpret_cast<block_type*>(std::calloc(capacity_, sizeof(block_type)));
+
+	if (!data_)
+	{
+		capacity_ = 0;
+		sign_ = false;
+		throw std::bad_alloc();
+	}
+
+	std::copy(integer.data_, integer.data_ + integer.capacity_, data_);
+	std::fill(data_ + integer.capacity_, data_ + capacity_, 0);
+
+	_BIGNUM_STATS_ALLOCATE(copy, sizeof(block_type) * capacity_);
+	_BIGNUM_STATS_OPERATION(copy, capacity_);
+}
+bigint::bigint(bigint&& integer) noexcept
+	: data_(integer.data_), capacity_(integer.capacity_), sign_(integer.sign_)
+{
+	integer.data_ = nullptr;
+	integer.capacity_ = 0;
+	integer.sign_ = false;
+}
+bigint::bigint(const bigint_view& integer)
+	: capacity_(integer.capacity()), sign_(integer.sign())
+{
+	if (capacity_)
+	{
+		data_ = reinterpret_cast<block_type*>(std::malloc(sizeof(block_type) * capacity_));
+
+		if (!data_)
+		{
+			capacity_ = 0;
+			sign_ = false;
+			throw std::bad_alloc();
+		}
+
+		std::copy(integer.data(), integer.data() + capacity_, data_);
+
+		_BIGNUM_STATS_ALLOCATE(construct, sizeof(block_type) * capacity_);
+	}
+
+	if (sign_ && zero())
+	{
+		sign_ = false;
+	}
+
+	_BIGNUM_STATS_OPERATION(construct, capacity_);
+}
+bigint::~bigint()
+{
+	reset();
+}
+
+bigint& bigint::operator=(const bigint& integer)
+{
+	_BIGNUM_STATS_OPERATION(assign, integer.capacity_);
+
+	reserve_(integer.capacity_, bigint_stats::site::assign);
+
+	sign_ = integer.sign_;
+	std::copy(integer.data_, integer.data_ + integer.capacity_, data_);
+
+	if (capacity_ > integer.capacity_)
+	{
+		std::fill(data_ + integer.capacity_, data_ + capacity_, 0);
+	}
+
+	return *this;
+}
+bigint& bigint::operator=(bigint&& integer) noexcept
+{
+	if (this == &integer) return *this;
+
+	std::free(data_);
+
+	data_ = integer.data_;
+	capacity_ = integer.capacity_;
+	sign_ = integer.sign_;
+
+	integer.data_ = nullptr;
+	integer.capacity_ = 0;
+	integer.sign_ = false;
+
+	return *this;
+}
+bool bigint::operator==(const bigint& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) == 0;
+}
+bool bigint::operator==(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) == 0;
+}
+bool bigint::operator!=(const bigint& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) != 0;
+}
+bool bigint::operator!=(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) != 0;
+}
+bool bigint::operator>(const bigint& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) > 0;
+}
+bool bigint::operator>(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) > 0;
+}
+bool bigint::operator>=(const bigint& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) >= 0;
+}
+bool bigint::operator>=(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) >= 0;
+}
+bool bigint::operator<(const bigint& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) < 0;
+}
+bool bigint::operator<(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) < 0;
+}
+bool bigint::operator<=(const bigint& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) <= 0;
+}
+bool bigint::operator<=(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) <= 0;
+}
+bigint bigint::operator+(const bigint& integer) const
+{
+	return bigint(*this) += integer;
+}
+bigint bigint::operator+(const bigint_view& integer) const
+{
+	return bigint(*this) += integer;
+}
+bigint& bigint::operator+=(const bigint& integer)
+{
+	return *this += bigint_view(integer);
+}
+bigint& bigint::operator+=(const bigint_view& integer)
+{
+	_BIGNUM_STATS_OPERATION(add, std::max(capacity_, integer.capacity()));
+
+	if (sign_ == integer.sign())
+	{
+		add_unsigned_(integer);
+	}
+	else
+	{
+		sub_unsigned_(integer);
+	}
+
+	return *this;
+}
+bigint& bigint::operator++()
+{
+	_BIGNUM_STATS_OPERATION(increment, capacity_);
+
+	if (sign_)
+	{
+		_BIGNUM_DETAILS::sub_1(data_, data_, capacity_, 1);
+
+		if (zero())
+		{
+			sign_ = false;
+		}
+	}
+	else if (_BIGNUM_DETAILS::add_1(data_, data_, capacity_, 1))
+	{
+		reserve_(capacity_ + 1, bigint_stats::site::increment);
+		data_[capacity_ - 1] = 1;
+	}
+
+	return *this;
+}
+bigint bigint::operator++(int)
+{
+	bigint ret = *this;
+	return ++(*this), ret;
+}
+bigint bigint::operator-(const bigint& integer) const
+{
+	return bigint(*this) -= integer;
+}
+bigint bigint::operator-(const bigint_view& integer) const
+{
+	return bigint(*this) -= integer;
+}
+bigint& bigint::operator-=(const bigint& integer)
+{
+	return *this -= bigint_view(integer);
+}
+bigint& bigint::operator-=(const bigint_view& integer)
+{
+	_BIGNUM_STATS_OPERATION(sub, std::max(capacity_, integer.capacity()));
+
+	if (sign_ == integer.sign())
+	{
+		sub_unsigned_(integer);
+	}
+	else
+	{
+		add_unsigned_(integer);
+	}
+
+	return *this;
+}
+bigint bigint::operator*(const bigint& integer) const
+{
+	return *this * bigint_view(integer);
+}
+bigint bigint::operator*(const bigint_view& integer) const
+{
+	const size_type this_size = _BIGNUM_DETAILS::used_size(data_, capacity_);
+	const size_type size = _BIGNUM_DETAILS::used_size(integer.data(), integer.capacity());
+
+	bigint result;
+
+	_BIGNUM_STATS_OPERATION(multiply, std::max(this_size, size));
+
+	if (!this_size || !size) return result;
+
+	result.reserve_(this_size + size, bigint_stats::site::multiply);
+
+	if (this_size >= size)
+	{
+		_BIGNUM_DETAILS::multiply(result.data_, data_, this_size, integer.data(), size);
+	}
+	else
+	{
+		_BIGNUM_DETAILS::multiply(result.data_, integer.data(), size, data_, this_size);
+	}
+
+	result.sign_ = sign_ != integer.sign();
+
+	return result;
+}
+bigint& bigint::operator*=(const bigint& integer)
+{
+	return *this *= bigint_view(integer);
+}
+bigint& bigint::operator*=(const bigint_view& integer)
+{
+	bigint result = *this * integer;
+
+	swap(result);
+
+	return *this;
+}
+bigint bigint::operator/(const bigint& integer) const
+{
+	return *this / bigint_view(integer);
+}
+bigint bigint::operator/(const bigint_view& integer) const
+{
+	bigint quotient, remainder;
+
+	divmod(*this, integer, quotient, remainder);
+
+	return quotient;
+}
+bigint& bigint::operator/=(const bigint& integer)
+{
+	return *this /= bigint_view(integer);
+}
+bigint& bigint::operator/=(const bigint_view& integer)
+{
+	bigint remainder;
+
+	divmod(*this, integer, *this, remainder);
+
+	return *this;
+}
+bigint bigint::operator%(const bigint& integer) const
+{
+	return *this % bigint_view(integer);
+}
+bigint bigint::operator%(const bigint_view& integer) const
+{
+	bigint quotient, remainder;
+
+	divmod(*this, integer, quotient, remainder);
+
+	return remainder;
+}
+bigint& bigint::operator%=(const bigint& integer)
+{
+	return *this %= bigint_view(integer);
+}
+bigint& bigint::operator%=(const bigint_view& integer)
+{
+	bigint quotient;
+
+	divmod(*this, integer, quotient, *this);
+
+	return *this;
+}
+bigint bigint::operator<<(size_type shift) const
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(data_, capacity_);
+
+	if (!size) return bigint();
+
+	bigint result(*this, std::max(capacity_, size + shift / 32 + 1));
+
+	result <<= shift;
+
+	return result;
+}
+bigint& bigint::operator<<=(size_type shift)
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(data_, capacity_);
+
+	_BIGNUM_STATS_OPERATION(shift, size);
+
+	if (!size || !shift) return *this;
+
+	const size_type blocks = shift / 32;
+	const unsigned bits = static_cast<unsigned>(shift % 32);
+
+	reserve_(size + blocks + (bits != 0), bigint_stats::site::shift);
+
+	if (bits)
+	{
+		data_[size + blocks] = _BIGNUM_DETAILS::lshift(data_ + blocks, data_, size, bits);
+	}
+	else
+	{
+		std::copy_backward(data_, data_ + size, data_ + size + blocks);
+	}
+
+	std::fill(data_, data_ + blocks, 0);
+
+	return *this;
+}
+bigint bigint::operator>>(size_type shift) const
+{
+	bigint result(*this);
+
+	result >>= shift;
+
+	return result;
+}
+// Rounds toward negative infinity, like >> on a two's complement integer.
+bigint& bigint::operator>>=(size_type shift)
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(data_, capacity_);
+
+	_BIGNUM_STATS_OPERATION(shift, size);
+
+	if (!size || !shift) return *this;
+
+	const size_type blocks = shift / 32;
+	const unsigned bits = static_cast<unsigned>(shift % 32);
+
+	if (blocks >= size)
+	{
+		std::fill(data_, data_ + capacity_, 0);
+
+		if (sign_)
+		{
+			data_[0] = 1;
+		}
+
+		return *this;
+	}
+
+	bool inexact = sign_ && _BIGNUM_DETAILS::used_size(data_, blocks) != 0;
+
+	if (bits)
+	{
+		inexact |= _BIGNUM_DETAILS::rshift(data_, data_ + blocks, size - blocks, bits) != 0 && sign_;
+	}
+	else
+	{
+		std::copy(data_ + blocks, data_ + size, data_);
+	}
+
+	std::fill(data_ + size - blocks, data_ + size, 0);
+
+	if (inexact)
+	{
+		_BIGNUM_DETAILS::add_1(data_, data_, size, 1);
+	}
+	else if (sign_ && zero())
+	{
+		sign_ = false;
+	}
+
+	return *this;
+}
+bool bigint::operator!() const noexcept
+{
+	return zero();
+}
+bigint::operator bool() const noexcept
+{
+	return !zero();
+}
+
+void bigint::reset() noexcept
+{
+	std::free(data_);
+
+	data_ = nullptr;
+	capacity_ = 0;
+	sign_ = false;
+}
+void bigint::swap(bigint& integer) noexcept
+{
+	if (this == &integer) return;
+
+	std::swap(data_, integer.data_);
+	std::swap(capacity_, integer.capacity_);
+	std::swap(sign_, integer.sign_);
+}
+
+void bigint::reserve(size_type new_capacity)
+{
+	reserve_(new_capacity, bigint_stats::site::reserve);
+}
+void bigint::shrink_to_fit()
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(data_, capacity_);
+
+	if (size == capacity_) return;
+	else if (!size)
+	{
+		reset();
+		return;
+	}
+
+	block_type* const new_data = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * size));
+
+	if (!new_data) throw std::bad_alloc();
+
+	data_ = new_data;
+	capacity_ = size;
+
+	_BIGNUM_STATS_REALLOCATE(shrink, sizeof(block_type) * size);
+}
+
+bool bigint::zero() const noexcept
+{
+	if (capacity_ == 0) return true;
+
+	for (size_type i = 0; i < capacity_; ++i)
+	{
+		if (data_[i]) return false;
+	}
+
+	return true;
+}
+bool bigint::positive() const noexcept
+{
+	return !sign_ && !zero();
+}
+bool bigint::negative() const noexcept
+{
+	return sign_;
+}
+
+bigint bigint::from_bytes(const void* bytes, size_type size, byte_order order, bool sign)
+{
+	bigint result;
+
+	if (!size) return result;
+
+	const size_type blocks = size / sizeof(block_type);
+	const size_type remainder = size % sizeof(block_type);
+	const unsigned char* const source = static_cast<const unsigned char*>(bytes);
+
+	_BIGNUM_STATS_OPERATION(from_bytes, blocks + (remainder != 0));
+
+	result.reserve_(blocks + (remainder != 0), bigint_stats::site::from_bytes);
+
+	if (order == byte_order::little)
+	{
+		if (_BIGNUM_DETAILS::host_little_endian)
+		{
+			std::memcpy(result.data_, source, size);
+		}
+		else
+		{
+			std::memcpy(result.data_, source, blocks * sizeof(block_type));
+
+			for (size_type i = 0; i < blocks; ++i)
+			{
+				result.data_[i] = _BIGNUM_DETAILS::byte_swap(result.data_[i]);
+			}
+			for (size_type i = 0; i < remainder; ++i)
+			{
+				result.data_[blocks] |= static_cast<block_type>(source[blocks * sizeof(block_type) + i]) << (i * 8);
+			}
+		}
+	}
+	else
+	{
+		const unsigned char* const end = source + size;
+
+		for (size_type i = 0; i < blocks; ++i)
+		{
+			std::memcpy(result.data_ + i, end - (i + 1) * sizeof(block_type), sizeof(block_type));
+		}
+
+		if (_BIGNUM_DETAILS::host_little_endian)
+		{
+			for (size_type i = 0; i < blocks; ++i)
+			{
+				result.data_[i] = _BIGNUM_DETAILS::byte_swap(result.data_[i]);
+			}
+		}
+
+		for (size_type i = 0; i < remainder; ++i)
+		{
+			result.data_[blocks] = (result.data_[blocks] << 8) | source[i];
+		}
+	}
+
+	result.sign_ = sign && !result.zero();
+
+	return result;
+}
+bigint::size_type bigint::byte_size() const noexcept
+{
+	return bigint_view(*this).byte_size();
+}
+void bigint::to_bytes(void* bytes, size_type size, byte_order order) const
+{
+	bigint_view(*this).to_bytes(bytes, size, order);
+}
+std::string bigint::to_string() const
+{
+	return bigint_view(*this).to_string();
+}
+
+// Truncates toward zero, so the remainder takes the sign of the dividend.
+void bigint::divmod(const bigint_view& dividend, const bigint_view& divisor, bigint& quotient, bigint& remainder)
+{
+	const size_type dividend_size = _BIGNUM_DETAILS::used_size(dividend.data(), dividend.capacity());
+	const size_type divisor_size = _BIGNUM_DETAILS::used_size(divisor.data(), divisor.capacity());
+
+	if (!divisor_size) throw std::invalid_argument("divisor == 0");
+
+	_BIGNUM_STATS_OPERATION(divide, dividend_size);
+
+	bigint result_quotient, result_remainder;
+
+	if (_BIGNUM_DETAILS::compare_unsigned(dividend.data(), dividend_size, divisor.data(), divisor_size) < 0)
+	{
+		result_remainder = bigint(dividend);
+	}
+	else
+	{
+		result_quotient.reserve_(dividend_size - divisor_size + 1, bigint_stats::site::divide);
+		result_remainder.reserve_(divisor_size, bigint_stats::site::divide);
+
+		_BIGNUM_DETAILS::divide(result_quotient.data_, result_remainder.data_, dividend.data(), dividend_size, divisor.data(), divisor_size);
+
+		result_quotient.sign_ = dividend.sign() != divisor.sign() && !result_quotient.zero();
+		result_remainder.sign_ = dividend.sign() && !result_remainder.zero();
+	}
+
+	quotient = std::move(result_quotient);
+	remainder = std::move(result_remainder);
+}
+bigint bigint::gcd(const bigint_view& a, const bigint_view& b)
+{
+	bigint x(a), y(b), quotient, remainder;
+
+	x.sign_ = false;
+	y.sign_ = false;
+
+	while (!y.zero())
+	{
+		divmod(x, y, quotient, remainder);
+		x.swap(y);
+		y.swap(remainder);
+	}
+
+	return x;
+}
+bool bigint::is_probable_prime(unsigned rounds) const
+{
+	return bigint_view(*this).is_probable_prime(rounds);
+}
+// Returns the smallest probable prime greater than integer. Candidates are sieved in windows
+// of odd numbers and the survivors of each window are tested on threads workers.
+bigint bigint::next_prime(const bigint_view& integer, unsigned rounds, unsigned threads)
+{
+	if (integer < bigint_view(bigint(2))) return 2;
+
+	bigint candidate = bigint(integer) + 1;
+
+	if (!(candidate.data_[0] & 1))
+	{
+		++candidate;
+	}
+
+	const _BIGNUM_DETAILS::small_primes& table = _BIGNUM_DETAILS::get_small_primes();
+	_BIGNUM_DETAILS::montgomery context;
+
+	// The sieve below would strike out the small primes themselves.
+	while (_BIGNUM_DETAILS::used_size(candidate.data_, candidate.capacity_) == 1 && candidate.data_[0] < table.limit)
+	{
+		if (_BIGNUM_DETAILS::probable_prime(candidate, rounds, context)) return candidate;
+
+		candidate += 2;
+	}
+
+	static constexpr size_type window = 4096;
+
+	const unsigned workers = _BIGNUM_DETAILS::thread_count(threads, window);
+	std::vector<_BIGNUM_DETAILS::montgomery> contexts(workers);
+	std::vector<bool> composite(window);
+	std::vector<size_type> survivors;
+
+	for (;; candidate += bigint(static_cast<std::uint64_t>(window * 2)))
+	{
+		const size_type size = _BIGNUM_DETAILS::used_size(candidate.data_, candidate.capacity_);
+
+		std::fill(composite.begin(), composite.end(), false);
+
+		for (const _BIGNUM_DETAILS::prime_group& group : table.groups)
+		{
+			const block_type remainder = _BIGNUM_DETAILS::mod_1(candidate.data_, size, group.product);
+
+			for (std::size_t i = std::max<std::size_t>(group.begin, 1); i < group.end; ++i)
+			{
+				const size_type prime = table.primes[i];
+				const size_type first = (prime - remainder % prime) % prime * ((prime + 1) / 2) % prime;
+
+				for (size_type j = first; j < window; j += prime)
+				{
+					composite[j] = true;
+				}
+			}
+		}
+
+		survivors.clear();
+
+		for (size_type i = 0; i < window; ++i)
+		{
+			if (!composite[i])
+			{
+				survivors.push_back(i);
+			}
+		}
+
+		std::atomic<std::size_t> found(survivors.size());
+
+		_BIGNUM_DETAILS::parallel_for(survivors.size(), workers, [&](std::size_t index, unsigned worker)
+		{
+			if (index >= found) return;
+
+			const bigint value = candidate + bigint(static_cast<std::uint64_t>(survivors[index] * 2));
+
+			if (_BIGNUM_DETAILS::probable_prime(value, rounds, contexts[worker]))
+			{
+				std::size_t current = found;
+
+				while (index < current && !found.compare_exchange_weak(current, index));
+			}
+		});
+
+		if (found < survivors.size())
+		{
+			return candidate + bigint(static_cast<std::uint64_t>(survivors[found] * 2));
+		}
+	}
+}
+// Keeps the probable primes of integers in their original order.
+std::vector<bigint> bigint::filter_primes(const std::vector<bigint>& integers, unsigned rounds, unsigned threads)
+{
+	const unsigned workers = _BIGNUM_DETAILS::thread_count(threads, integers.size());
+	std::vector<_BIGNUM_DETAILS::montgomery> contexts(workers);
+	std::vector<char> primes(integers.size());
+
+	_BIGNUM_DETAILS::parallel_for(integers.size(), workers, [&](std::size_t index, unsigned worker)
+	{
+		primes[index] = _BIGNUM_DETAILS::probable_prime(integers[index], rounds, contexts[worker]);
+	});
+
+	std::vector<bigint> result;
+
+	for (std::size_t i = 0; i < integers.size(); ++i)
+	{
+		if (primes[i])
+		{
+			result.push_back(integers[i]);
+		}
+	}
+
+	return result;
+}
+
+const char* bigint::kernel_name() noexcept
+{
+	return _BIGNUM_DETAILS::kernels().name;
+}
+
+void bigint::add_unsigned_(const bigint_view& integer)
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(integer.data(), integer.capacity());
+
+	if (!size) return;
+	else if (integer.data() == data_)
+	{
+		const bigint copy(*this);
+
+		add_unsigned_(copy);
+		return;
+	}
+
+	const size_type new_size = std::max(_BIGNUM_DETAILS::used_size(data_, capacity_), size);
+
+	reserve_(new_size, bigint_stats::site::add);
+
+	if (_BIGNUM_DETAILS::add_blocks(data_, data_, new_size, integer.data(), size))
+	{
+		reserve_(new_size + 1, bigint_stats::site::add);
+		data_[new_size] = 1;
+	}
+}
+void bigint::sub_unsigned_(const bigint_view& integer)
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(integer.data(), integer.capacity());
+
+	if (!size) return;
+	else if (integer.data() == data_)
+	{
+		std::fill(data_, data_ + capacity_, 0);
+		sign_ = false;
+
+		return;
+	}
+
+	const size_type this_size = _BIGNUM_DETAILS::used_size(data_, capacity_);
+
+	if (_BIGNUM_DETAILS::compare_unsigned(data_, this_size, integer.data(), size) >= 0)
+	{
+		_BIGNUM_DETAILS::sub_blocks(data_, data_, this_size, integer.data(), size);
+	}
+	else
+	{
+		reserve_(size, bigint_stats::site::sub);
+
+		_BIGNUM_DETAILS::sub_blocks(data_, integer.data(), size, data_, this_size);
+		sign_ = !sign_;
+	}
+
+	if (sign_ && zero())
+	{
+		sign_ = false;
+	}
+}
+void bigint::reserve_(size_type new_capacity, bigint_stats::site site)
+{
+	if (new_capacity > capacity_)
+	{
+		block_type* const old_data = data_;
+		const size_type old_capacity = capacity_;
+
+		data_ = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * new_capacity));
+		capacity_ = new_capacity;
+
+		if (!data_)
+		{
+			data_ = old_data;
+			capacity_ = old_capacity;
+			throw std::bad_alloc();
+		}
+
+		std::fill(data_ + old_capacity, data_ + capacity_, 0);
+
+#ifdef _BIGNUM_STATS
+		if (old_data)
+		{
+			_BIGNUM_DETAILS::stats_reallocate(site, sizeof(block_type) * new_capacity);
+		}
+		else
+		{
+			_BIGNUM_DETAILS::stats_allocate(site, sizeof(block_type) * new_capacity);
+		}
+#else
+		static_cast<void>(site);
+#endif
+	}
+}
+
+const bigint::block_type* bigint::data() const noexcept
+{
+	return data_;
+}
+bigint::block_type* bigint::data() noexcept
+{
+	return data_;
+}
+bigint::size_type bigint::capacity() const noexcept
+{
+	return capacity_;
+}
+bool bigint::sign() const noexcept
+{
+	return sign_;
+}
+
+bigint_view::bigint_view(const bigint& integer) noexcept
+	: data_(integer.data()), capacity_(integer.capacity()), sign_(integer.sign())
+{}
+
+bool bigint_view::operator==(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) == 0;
+}
+bool bigint_view::operator!=(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) != 0;
+}
+bool bigint_view::operator>(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) > 0;
+}
+bool bigint_view::operator>=(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) >= 0;
+}
+bool bigint_view::operator<(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) < 0;
+}
+bool bigint_view::operator<=(const bigint_view& integer) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, integer) <= 0;
+}
+bigint bigint_view::operator+(const bigint_view& integer) const
+{
+	return bigint(*this) += integer;
+}
+bigint bigint_view::operator-(const bigint_view& integer) const
+{
+	return bigint(*this) -= integer;
+}
+bigint bigint_view::operator*(const bigint_view& integer) const
+{
+	return bigint(*this) *= integer;
+}
+bigint bigint_view::operator/(const bigint_view& integer) const
+{
+	return bigint(*this) /= integer;
+}
+bigint bigint_view::operator%(const bigint_view& integer) const
+{
+	return bigint(*this) %= integer;
+}
+bigint bigint_view::operator<<(size_type shift) const
+{
+	bigint result(*this);
+
+	result <<= shift;
+
+	return result;
+}
+bigint bigint_view::operator>>(size_type shift) const
+{
+	bigint result(*this);
+
+	result >>= shift;
+
+	return result;
+}
+bool bigint_view::operator!() const noexcept
+{
+	return zero();
+}
+bigint_view::operator bool() const noexcept
+{
+	return !zero();
+}
+
+bool bigint_view::zero() const noexcept
+{
+	return _BIGNUM_DETAILS::used_size(data_, capacity_) == 0;
+}
+bool bigint_view::positive() const noexcept
+{
+	return !sign_ && !zero();
+}
+bool bigint_view::negative() const noexcept
+{
+	return sign_ && !zero();
+}
+
+bigint_view::size_type bigint_view::byte_size() const noexcept
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(data_, capacity_);
+
+	if (!size) return 0;
+
+	size_type result = size * sizeof(block_type);
+
+	for (block_type top = data_[size - 1]; !(top & 0xFF000000); top <<= 8)
+	{
+		--result;
+	}
+
+	return result;
+}
+void bigint_view::to_bytes(void* bytes, size_type size, byte_order order) const
+{
+	const size_type used_bytes = byte_size();
+
+	if (size < used_bytes) throw std::invalid_argument("size < byte_size()");
+
+	_BIGNUM_STATS_OPERATION(to_bytes, _BIGNUM_DETAILS::used_size(data_, capacity_));
+
+	unsigned char* const target = static_cast<unsigned char*>(bytes);
+	const size_type blocks = used_bytes / sizeof(block_type);
+	const size_type remainder = used_bytes % sizeof(block_type);
+
+	if (order == byte_order::little)
+	{
+		if (_BIGNUM_DETAILS::host_little_endian)
+		{
+			std::memcpy(target, data_, used_bytes);
+		}
+		else
+		{
+			for (size_type i = 0; i < blocks; ++i)
+			{
+				const block_type block = _BIGNUM_DETAILS::byte_swap(data_[i]);
+
+				std::memcpy(target + i * sizeof(block_type), &block, sizeof(block_type));
+			}
+			for (size_type i = 0; i < remainder; ++i)
+			{
+				target[blocks * sizeof(block_type) + i] = static_cast<unsigned char>(data_[blocks] >> (i * 8));
+			}
+		}
+
+		std::fill(target + used_bytes, target + size, 0);
+	}
+	else
+	{
+		unsigned char* const end = target + size;
+
+		for (size_type i = 0; i < blocks; ++i)
+		{
+			const block_type block = _BIGNUM_DETAILS::host_little_endian ? _BIGNUM_DETAILS::byte_swap(data_[i]) : data_[i];
+
+			std::memcpy(end - (i + 1) * sizeof(block_type), &block, sizeof(block_type));
+		}
+		for (size_type i = 0; i < remainder; ++i)
+		{
+			*(end - blocks * sizeof(block_type) - 1 - i) = static_cast<unsigned char>(data_[blocks] >> (i * 8));
+		}
+
+		std::fill(target, end - used_bytes, 0);
+	}
+}
+std::string bigint_view::to_string() const
+{
+	size_type size = _BIGNUM_DETAILS::used_size(data_, capacity_);
+
+	_BIGNUM_STATS_OPERATION(to_string, size);
+
+	if (!size) return "0";
+
+	std::vector<block_type> blocks(data_, data_ + size);
+	std::vector<block_type> chunks;
+
+	chunks.reserve(size * 32 / 29 + 1);
+
+	while (size)
+	{
+		std::uint64_t remainder = 0;
+
+		for (size_type i = size; i-- > 0;)
+		{
+			const std::uint64_t dividend = (remainder << 32) | blocks[i];
+
+			blocks[i] = static_cast<block_type>(dividend / 1000000000);
+			remainder = dividend % 1000000000;
+		}
+
+		chunks.push_back(static_cast<block_type>(remainder));
+		size = _BIGNUM_DETAILS::used_size(blocks.data(), size);
+	}
+
+	std::string result = sign_ ? "-" : "";
+
+	result += std::to_string(chunks.back());
+	result.reserve(result.size() + (chunks.size() - 1) * 9);
+
+	for (size_type i = chunks.size() - 1; i-- > 0;)
+	{
+		const std::string chunk = std::to_string(chunks[i]);
+
+		result.append(9 - chunk.size(), '0');
+		result += chunk;
+	}
+
+	return result;
+}
+bool bigint_view::is_probable_prime(unsigned rounds) const
+{
+	_BIGNUM_DETAILS::montgomery context;
+
+	return _BIGNUM_DETAILS::probable_prime(*this, rounds, context);
+}
+
+bigint_array::bigint_array(const bigint_array& array)
+{
+	if (array.size_)
+	{
+		reserve(array.size_, array.blocks_);
+
+		std::copy(array.index_, array.index_ + array.size_ + 1, index_);
+		std::copy(array.data_, array.data_ + array.blocks_, data_);
+
+		size_ = array.size_;
+		blocks_ = array.blocks_;
+	}
+}
+bigint_array::bigint_array(bigint_array&& array) noexcept
+	: index_(array.index_), data_(array.data_), size_(array.size_), capacity_(array.capacity_), blocks_(array.blocks_),
+	block_capacity_(array.block_capacity_), mapping_(array.mapping_), mapping_size_(array.mapping_size_)
+{
+	array.index_ = nullptr;
+	array.data_ = nullptr;
+	array.size_ = 0;
+	array.capacity_ = 0;
+	array.blocks_ = 0;
+	array.block_capacity_ = 0;
+	array.mapping_ = nullptr;
+	array.mapping_size_ = 0;
+}
+bigint_array::~bigint_array()
+{
+	reset();
+}
+
+bigint_array& bigint_array::operator=(const bigint_array& array)
+{
+	if (this == &array) return *this;
+
+	bigint_array(array).swap(*this);
+
+	return *this;
+}
+bigint_array& bigint_array::operator=(bigint_array&& array) noexcept
+{
+	if (this == &array) return *this;
+
+	reset();
+	swap(array);
+
+	return *this;
+}
+bigint_view bigint_array::operator[](size_type index) const noexcept
+{
+	const std::uint64_t begin = index_[index];
+	const std::uint64_t end = index_[index + 1] & ~_BIGNUM_DETAILS::array_sign;
+	const std::uint64_t offset = begin & ~_BIGNUM_DETAILS::array_sign;
+
+	return bigint_view(data_ + offset, static_cast<size_type>(end - offset), (begin & _BIGNUM_DETAILS::array_sign) != 0);
+}
+
+void bigint_array::reset() noexcept
+{
+	if (mapping_)
+	{
+		_BIGNUM_DETAILS::unmap_file(mapping_, mapping_size_);
+	}
+	else
+	{
+		std::free(index_);
+		std::free(data_);
+	}
+
+	index_ = nullptr;
+	data_ = nullptr;
+	size_ = 0;
+	capacity_ = 0;
+	blocks_ = 0;
+	block_capacity_ = 0;
+	mapping_ = nullptr;
+	mapping_size_ = 0;
+}
+void bigint_array::swap(bigint_array& array) noexcept
+{
+	if (this == &array) return;
+
+	std::swap(index_, array.index_);
+	std::swap(data_, array.data_);
+	std::swap(size_, array.size_);
+	std::swap(capacity_, array.capacity_);
+	std::swap(blocks_, array.blocks_);
+	std::swap(block_capacity_, array.block_capacity_);
+	std::swap(mapping_, array.mapping_);
+	std::swap(mapping_size_, array.mapping_size_);
+}
+
+void bigint_array::reserve(size_type new_capacity, size_type new_block_capacity)
+{
+	if (mapping_ || !index_ || new_capacity > capacity_ || new_block_capacity > block_capacity_)
+	{
+		detach_(std::max(new_capacity, capacity_), std::max(new_block_capacity, block_capacity_));
+	}
+}
+void bigint_array::push_back(const bigint_view& integer)
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(integer.data(), integer.capacity());
+
+	if (size && !std::less<const block_type*>()(integer.data(), data_) && std::less<const block_type*>()(integer.data(), data_ + blocks_))
+	{
+		const bigint copy(integer);
+
+		push_back(copy);
+		return;
+	}
+
+	if (mapping_ || !index_ || size_ == capacity_ || blocks_ + size > block_capacity_)
+	{
+		detach_(size_ == capacity_ ? std::max<size_type>(capacity_ * 2, 8) : capacity_,
+			blocks_ + size > block_capacity_ ? std::max(block_capacity_ * 2, blocks_ + size) : block_capacity_);
+	}
+
+	std::copy(integer.data(), integer.data() + size, data_ + blocks_);
+
+	index_[size_] = blocks_ | (size && integer.sign() ? _BIGNUM_DETAILS::array_sign : 0);
+	blocks_ += size;
+	index_[++size_] = blocks_;
+}
+bigint_view bigint_array::at(size_type index) const
+{
+	if (index >= size_) throw std::out_of_range("index >= size()");
+
+	return (*this)[index];
+}
+
+bool bigint_array::empty() const noexcept
+{
+	return size_ == 0;
+}
+bigint_array::size_type bigint_array::size() const noexcept
+{
+	return size_;
+}
+bigint_array::size_type bigint_array::blocks() const noexcept
+{
+	return blocks_;
+}
+bool bigint_array::mapped() const noexcept
+{
+	return mapping_ != nullptr;
+}
+
+void bigint_array::save(const char* path) const
+{
+	std::FILE* const file = std::fopen(path, "wb");
+
+	if (!file) throw std::runtime_error("cannot open file");
+
+	_BIGNUM_DETAILS::array_header header;
+
+	std::copy(_BIGNUM_DETAILS::array_magic, _BIGNUM_DETAILS::array_magic + 8, header.magic);
+	header.version = _BIGNUM_DETAILS::array_version;
+	header.byte_order = _BIGNUM_DETAILS::array_byte_order;
+	header.size = size_;
+	header.blocks = blocks_;
+
+	const std::uint64_t empty_index = 0;
+	bool succeeded = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+	succeeded = succeeded && (index_ ? std::fwrite(index_, sizeof(std::uint64_t), size_ + 1, file) == size_ + 1 : std::fwrite(&empty_index, sizeof(std::uint64_t), 1, file) == 1);
+	succeeded = succeeded && (!blocks_ || std::fwrite(data_, sizeof(block_type), blocks_, file) == blocks_);
+	succeeded = std::fclose(file) == 0 && succeeded;
+
+	if (!succeeded) throw std::runtime_error("cannot write file");
+}
+bigint_array bigint_array::load(const char* path)
+{
+	bigint_array result;
+
+	result.mapping_ = _BIGNUM_DETAILS::map_file(path, result.mapping_size_);
+
+	const unsigned char* const image = static_cast<const unsigned char*>(result.mapping_);
+	_BIGNUM_DETAILS::array_header header;
+
+	if (result.mapping_size_ < sizeof(header) + sizeof(std::uint64_t)) throw std::runtime_error("invalid bigint_array file");
+
+	std::memcpy(&header, image, sizeof(header));
+
+	if (!std::equal(header.magic, header.magic + 8, _BIGNUM_DETAILS::array_magic) || header.version != _BIGNUM_DETAILS::array_version ||
+		header.byte_order != _BIGNUM_DETAILS::array_byte_order) throw std::runtime_error("invalid bigint_array file");
+
+	const size_type available = result.mapping_size_ - sizeof(header);
+
+	if (header.size >= available / sizeof(std::uint64_t) ||
+		header.blocks > (available - (header.size + 1) * sizeof(std::uint64_t)) / sizeof(block_type)) throw std::runtime_error("invalid bigint_array file");
+
+	// The image is used in place; mapped arrays are copied into owned storage before they are modified.
+	result.index_ = reinterpret_cast<std::uint64_t*>(const_cast<unsigned char*>(image + sizeof(header)));
+	result.data_ = reinterpret_cast<block_type*>(const_cast<unsigned char*>(image + sizeof(header) + (header.size + 1) * sizeof(std::uint64_t)));
+	result.size_ = result.capacity_ = static_cast<size_type>(header.size);
+	result.blocks_ = result.block_capacity_ = static_cast<size_type>(header.blocks);
+
+	std::uint64_t offset = 0;
+
+	for (size_type i = 0; i <= result.size_; ++i)
+	{
+		const std::uint64_t next = result.index_[i] & ~_BIGNUM_DETAILS::array_sign;
+
+		if (next < offset || next > header.blocks) throw std::runtime_error("invalid bigint_array file");
+
+		offset = next;
+	}
+
+	if (offset != header.blocks) throw std::runtime_error("invalid bigint_array file");
+
+	return result;
+}
+
+void bigint_array::detach_(size_type new_capacity, size_type new_block_capacity)
+{
+	if (mapping_)
+	{
+		std::uint64_t* const new_index = reinterpret_cast<std::uint64_t*>(std::malloc(sizeof(std::uint64_t) * (new_capacity + 1)));
+		block_type* const new_data = new_block_capacity ? reinterpret_cast<block_type*>(std::malloc(sizeof(block_type) * new_block_capacity)) : nullptr;
+
+		if (!new_index || (new_block_capacity && !new_data))
+		{
+			std::free(new_index);
+			std::free(new_data);
+			throw std::bad_alloc();
+		}
+
+		std::copy(index_, index_ + size_ + 1, new_index);
+		std::copy(data_, data_ + blocks_, new_data);
+
+		_BIGNUM_DETAILS::unmap_file(mapping_, mapping_size_);
+
+		_BIGNUM_STATS_ALLOCATE(array, sizeof(std::uint64_t) * (new_capacity + 1));
+		if (new_block_capacity)
+		{
+			_BIGNUM_STATS_ALLOCATE(array, sizeof(block_type) * new_block_capacity);
+		}
+
+		index_ = new_index;
+		data_ = new_data;
+		mapping_ = nullptr;
+		mapping_size_ = 0;
+	}
+	else
+	{
+		if (!index_ || new_capacity > capacity_)
+		{
+			std::uint64_t* const new_index = reinterpret_cast<std::uint64_t*>(std::realloc(index_, sizeof(std::uint64_t) * (new_capacity + 1)));
+
+			if (!new_index) throw std::bad_alloc();
+			else if (!index_)
+			{
+				new_index[0] = 0;
+
+				_BIGNUM_STATS_ALLOCATE(array, sizeof(std::uint64_t) * (new_capacity + 1));
+			}
+			else
+			{
+				_BIGNUM_STATS_REALLOCATE(array, sizeof(std::uint64_t) * (new_capacity + 1));
+			}
+
+			index_ = new_index;
+		}
+
+		if (new_block_capacity > block_capacity_)
+		{
+			block_type* const new_data = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * new_block_capacity));
+
+			if (!new_data) throw std::bad_alloc();
+			else if (!data_)
+			{
+				_BIGNUM_STATS_ALLOCATE(array, sizeof(block_type) * new_block_capacity);
+			}
+			else
+			{
+				_BIGNUM_STATS_REALLOCATE(array, sizeof(block_type) * new_block_capacity);
+			}
+
+			data_ = new_data;
+		}
+	}
+
+	capacity_ = new_capacity;
+	block_capacity_ = std::max(new_block_capacity, block_capacity_);
+}
+
+const std::uint64_t* bigint_array::index() const noexcept
+{
+	return index_;
+}
+const bigint_array::block_type* bigint_array::data() const noexcept
+{
+	return data_;
+}
+bigint_array::size_type bigint_array::capacity() const noexcept
+{
+	return capacity_;
+}
+bigint_array::size_type bigint_array::block_capacity() const noexcept
+{
+	return block_capacity_;
+}
+
+bigint_file::bigint_file(const char* directory)
+	: directory_(directory ? directory : "")
+{}
+bigint_file::bigint_file(const bigint_view& integer, const char* directory)
+	: directory_(directory ? directory : "")
+{
+	*this = integer;
+}
+bigint_file::bigint_file(bigint_file&& integer) noexcept
+	: data_(integer.data_), capacity_(integer.capacity_), sign_(integer.sign_), file_(integer.file_), directory_(std::move(integer.directory_))
+{
+	integer.data_ = nullptr;
+	integer.capacity_ = 0;
+	integer.sign_ = false;
+	integer.file_ = -1;
+}
+bigint_file::~bigint_file()
+{
+	reset();
+}
+
+bigint_file& bigint_file::operator=(bigint_file&& integer) noexcept
+{
+	if (this == &integer) return *this;
+
+	reset();
+	swap(integer);
+
+	return *this;
+}
+bigint_file& bigint_file::operator=(const bigint_view& integer)
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(integer.data(), integer.capacity());
+
+	if (integer.data() != data_)
+	{
+		reserve(size);
+
+		for (size_type i = 0; i < size; i += _BIGNUM_DETAILS::file_tile)
+		{
+			const size_type tile = std::min(_BIGNUM_DETAILS::file_tile, size - i);
+
+			_BIGNUM_DETAILS::advise_willneed(integer.data() + i + tile, sizeof(block_type) * std::min(_BIGNUM_DETAILS::file_tile, size - i - tile));
+			std::copy(integer.data() + i, integer.data() + i + tile, data_ + i);
+		}
+
+		std::fill(data_ + size, data_ + capacity_, 0);
+	}
+
+	sign_ = size && integer.sign();
+
+	return *this;
+}
+bool bigint_file::operator==(const bigint_view& integer) const noexcept
+{
+	return compare_(integer) == 0;
+}
+bool bigint_file::operator!=(const bigint_view& integer) const noexcept
+{
+	return compare_(integer) != 0;
+}
+bool bigint_file::operator>(const bigint_view& integer) const noexcept
+{
+	return compare_(integer) > 0;
+}
+bool bigint_file::operator>=(const bigint_view& integer) const noexcept
+{
+	return compare_(integer) >= 0;
+}
+bool bigint_file::operator<(const bigint_view& integer) const noexcept
+{
+	return compare_(integer) < 0;
+}
+bool bigint_file::operator<=(const bigint_view& integer) const noexcept
+{
+	return compare_(integer) <= 0;
+}
+bigint_file& bigint_file::operator+=(const bigint_view& integer)
+{
+	if (sign_ == integer.sign())
+	{
+		add_unsigned_(integer);
+	}
+	else
+	{
+		sub_unsigned_(integer);
+	}
+
+	return *this;
+}
+bigint_file& bigint_file::operator-=(const bigint_view& integer)
+{
+	if (sign_ == integer.sign())
+	{
+		sub_unsigned_(integer);
+	}
+	else
+	{
+		add_unsigned_(integer);
+	}
+
+	return *this;
+}
+bigint_file& bigint_file::operator*=(const bigint_view& integer)
+{
+	bigint_file result(directory_.empty() ? nullptr : directory_.c_str());
+
+	multiply(result, *this, integer);
+	swap(result);
+
+	return *this;
+}
+bigint_file::operator bigint_view() const noexcept
+{
+	return bigint_view(data_, capacity_, sign_);
+}
+
+void bigint_file::reset() noexcept
+{
+	_BIGNUM_DETAILS::unmap_file(data_, sizeof(block_type) * capacity_);
+	_BIGNUM_DETAILS::close_file(file_);
+
+	data_ = nullptr;
+	capacity_ = 0;
+	sign_ = false;
+	file_ = -1;
+}
+void bigint_file::swap(bigint_file& integer) noexcept
+{
+	if (this == &integer) return;
+
+	std::swap(data_, integer.data_);
+	std::swap(capacity_, integer.capacity_);
+	std::swap(sign_, integer.sign_);
+	std::swap(file_, integer.file_);
+	directory_.swap(integer.directory_);
+}
+
+void bigint_file::reserve(size_type new_capacity)
+{
+	if (new_capacity <= capacity_) return;
+
+	if (file_ == -1)
+	{
+		file_ = _BIGNUM_DETAILS::create_temporary_file(directory_.empty() ? nullptr : directory_.c_str());
+	}
+
+	std::size_t new_size = sizeof(block_type) * std::max(new_capacity, capacity_ + capacity_ / 2);
+
+	new_size = (new_size + _BIGNUM_DETAILS::file_granularity - 1) / _BIGNUM_DETAILS::file_granularity * _BIGNUM_DETAILS::file_granularity;
+	data_ = reinterpret_cast<block_type*>(_BIGNUM_DETAILS::map_temporary_file(file_, data_, sizeof(block_type) * capacity_, new_size));
+	capacity_ = new_size / sizeof(block_type);
+}
+
+bool bigint_file::zero() const noexcept
+{
+	return _BIGNUM_DETAILS::used_size(data_, capacity_) == 0;
+}
+bool bigint_file::positive() const noexcept
+{
+	return !sign_ && !zero();
+}
+bool bigint_file::negative() const noexcept
+{
+	return sign_ && !zero();
+}
+
+void bigint_file::multiply(bigint_file& result, const bigint_view& a, const bigint_view& b)
+{
+	if (result.data_ && (a.data() == result.data_ || b.data() == result.data_)) throw std::invalid_argument("result overlaps an operand");
+
+	const size_type a_size = _BIGNUM_DETAILS::used_size(a.data(), a.capacity());
+	const size_type b_size = _BIGNUM_DETAILS::used_size(b.data(), b.capacity());
+	const size_type size = a_size + b_size;
+
+	result.sign_ = false;
+
+	if (!a_size || !b_size)
+	{
+		std::fill(result.data_, result.data_ + result.capacity_, 0);
+		return;
+	}
+
+	result.reserve(size);
+	std::fill(result.data_, result.data_ + result.capacity_, 0);
+
+	// Every product tile is added into a window of the result that slides forward with a, so all three streams are read in order.
+	std::vector<block_type> product(2 * _BIGNUM_DETAILS::file_tile);
+
+	for (size_type j = 0; j < b_size; j += _BIGNUM_DETAILS::file_tile)
+	{
+		const size_type b_tile = std::min(_BIGNUM_DETAILS::file_tile, b_size - j);
+
+		for (size_type i = 0; i < a_size; i += _BIGNUM_DETAILS::file_tile)
+		{
+			const size_type a_tile = std::min(_BIGNUM_DETAILS::file_tile, a_size - i);
+			block_type* const target = result.data_ + i + j;
+
+			_BIGNUM_DETAILS::advise_willneed(a.data() + i + a_tile, sizeof(block_type) * std::min(_BIGNUM_DETAILS::file_tile, a_size - i - a_tile));
+
+			if (a_tile >= b_tile)
+			{
+				_BIGNUM_DETAILS::mul_basecase(product.data(), a.data() + i, a_tile, b.data() + j, b_tile);
+			}
+			else
+			{
+				_BIGNUM_DETAILS::mul_basecase(product.data(), b.data() + j, b_tile, a.data() + i, a_tile);
+			}
+
+			const block_type carry = _BIGNUM_DETAILS::add_n(target, target, product.data(), a_tile + b_tile, 0);
+
+			_BIGNUM_DETAILS::add_1(target + a_tile + b_tile, target + a_tile + b_tile, size - (i + j + a_tile + b_tile), carry);
+		}
+	}
+
+	result.sign_ = a.sign() != b.sign();
+}
+
+int bigint_file::compare_(const bigint_view& integer) const noexcept
+{
+	const bigint_view view = *this;
+
+	if (view.zero() || integer.zero() || sign_ != integer.sign()) return _BIGNUM_DETAILS::compare(view, integer);
+
+	const int result = compare_unsigned_(integer);
+
+	return sign_ ? -result : result;
+}
+int bigint_file::compare_unsigned_(const bigint_view& integer) const noexcept
+{
+	const size_type this_size = _BIGNUM_DETAILS::used_size(data_, capacity_);
+	const size_type size = _BIGNUM_DETAILS::used_size(integer.data(), integer.capacity());
+
+	if (this_size != size) return this_size > size ? 1 : -1;
+
+	for (size_type end = size; end;)
+	{
+		const size_type tile = std::min(_BIGNUM_DETAILS::file_tile, end);
+		const size_type next_tile = std::min(_BIGNUM_DETAILS::file_tile, end - tile);
+
+		_BIGNUM_DETAILS::advise_willneed(data_ + end - tile - next_tile, sizeof(block_type) * next_tile);
+		_BIGNUM_DETAILS::advise_willneed(integer.data() + end - tile - next_tile, sizeof(block_type) * next_tile);
+
+		const int result = _BIGNUM_DETAILS::compare_unsigned(data_ + end - tile, tile, integer.data() + end - tile, tile);
+
+		if (result) return result;
+
+		end -= tile;
+	}
+
+	return 0;
+}
+void bigint_file::add_unsigned_(const bigint_view& integer)
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(integer.data(), integer.capacity());
+
+	if (!size) return;
+
+	const size_type new_size = std::max(_BIGNUM_DETAILS::used_size(data_, capacity_), size);
+
+	reserve(new_size);
+
+	block_type carry = 0;
+
+	for (size_type i = 0; i < size; i += _BIGNUM_DETAILS::file_tile)
+	{
+		const size_type tile = std::min(_BIGNUM_DETAILS::file_tile, size - i);
+
+		_BIGNUM_DETAILS::advise_willneed(integer.data() + i + tile, sizeof(block_type) * std::min(_BIGNUM_DETAILS::file_tile, size - i - tile));
+		carry = _BIGNUM_DETAILS::add_n(data_ + i, data_ + i, integer.data() + i, tile, carry);
+	}
+
+	if (_BIGNUM_DETAILS::add_1(data_ + size, data_ + size, new_size - size, carry))
+	{
+		reserve(new_size + 1);
+		data_[new_size] = 1;
+	}
+}
+void bigint_file::sub_unsigned_(const bigint_view& integer)
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(integer.data(), integer.capacity());
+
+	if (!size) return;
+	else if (integer.data() == data_)
+	{
+		std::fill(data_, data_ + capacity_, 0);
+		sign_ = false;
+
+		return;
+	}
+
+	const size_type this_size = _BIGNUM_DETAILS::used_size(data_, capacity_);
+	const bool swapped = compare_unsigned_(integer) < 0;
+	const size_type a_size = swapped ? size : this_size;
+	const size_type b_size = swapped ? this_size : size;
+
+	reserve(a_size);
+
+	const block_type* const a = swapped ? integer.data() : data_;
+	const block_type* const b = swapped ? data_ : integer.data();
+	block_type borrow = 0;
+
+	for (size_type i = 0; i < b_size; i += _BIGNUM_DETAILS::file_tile)
+	{
+		const size_type tile = std::min(_BIGNUM_DETAILS::file_tile, b_size - i);
+
+		_BIGNUM_DETAILS::advise_willneed(integer.data() + i + tile, sizeof(block_type) * std::min(_BIGNUM_DETAILS::file_tile, size - std::min(size, i + tile)));
+		borrow = _BIGNUM_DETAILS::sub_n(data_ + i, a + i, b + i, tile, borrow);
+	}
+
+	_BIGNUM_DETAILS::sub_1(data_ + b_size, a + b_size, a_size - b_size, borrow);
+
+	if (swapped)
+	{
+		sign_ = !sign_;
+	}
+
+	if (sign_ && zero())
+	{
+		sign_ = false;
+	}
+}
+
+const bigint_file::block_type* bigint_file::data() const noexcept
+{
+	return data_;
+}
+bigint_file::block_type* bigint_file::data() noexcept
+{
+	return data_;
+}
+bigint_file::size_type bigint_file::capacity() const noexcept
+{
+	return capacity_;
+}
+bool bigint_file::sign() const noexcept
+{
+	return sign_;
+}
+
+bigint_accumulator::bigint_accumulator(const bigint_accumulator& accumulator)
+	: capacity_(accumulator.capacity_), pending_(accumulator.pending_)
+{
+	if (accumulator.capacity_)
+	{
+		data_ = reinterpret_cast<block_type*>(std::malloc(sizeof(block_type) * capacity_));
+
+		if (!data_)
+		{
+			capacity_ = 0;
+			pending_ = 0;
+			throw std::bad_alloc();
+		}
+
+		std::copy(accumulator.data_, accumulator.data_ + accumulator.capacity_, data_);
+
+		_BIGNUM_STATS_ALLOCATE(accumulator, sizeof(block_type) * capacity_);
+	}
+}
+bigint_accumulator::bigint_accumulator(bigint_accumulator&& accumulator) noexcept
+	: data_(accumulator.data_), capacity_(accumulator.capacity_), pending_(accumulator.pending_)
+{
+	accumulator.data_ = nullptr;
+	accumulator.capacity_ = 0;
+	accumulator.pending_ = 0;
+}
+bigint_accumulator::~bigint_accumulator()
+{
+	reset();
+}
+
+bigint_accumulator& bigint_accumulator::operator=(const bigint_accumulator& accumulator)
+{
+	if (this == &accumulator) return *this;
+
+	if (capacity_ < accumulator.capacity_)
+	{
+		block_type* const new_data = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * accumulator.capacity_));
+
+		if (!new_data) throw std::bad_alloc();
+
+		if (data_)
+		{
+			_BIGNUM_STATS_REALLOCATE(accumulator, sizeof(block_type) * accumulator.capacity_);
+		}
+		else
+		{
+			_BIGNUM_STATS_ALLOCATE(accumulator, sizeof(block_type) * accumulator.capacity_);
+		}
+
+		data_ = new_data;
+		capacity_ = accumulator.capacity_;
+	}
+
+	std::copy(accumulator.data_, accumulator.data_ + accumulator.capacity_, data_);
+	std::fill(data_ + accumulator.capacity_, data_ + capacity_, 0);
+	pending_ = accumulator.pending_;
+
+	return *this;
+}
+bigint_accumulator& bigint_accumulator::operator=(bigint_accumulator&& accumulator) noexcept
+{
+	if (this == &accumulator) return *this;
+
+	std::free(data_);
+
+	data_ = accumulator.data_;
+	capacity_ = accumulator.capacity_;
+	pending_ = accumulator.pending_;
+
+	accumulator.data_ = nullptr;
+	accumulator.capacity_ = 0;
+	accumulator.pending_ = 0;
+
+	return *this;
+}
+bigint_accumulator& bigint_accumulator::operator+=(const bigint_view& integer)
+{
+	add_blocks_(integer.data(), integer.capacity(), integer.sign());
+	return *this;
+}
+bigint_accumulator& bigint_accumulator::operator-=(const bigint_view& integer)
+{
+	add_blocks_(integer.data(), integer.capacity(), !integer.sign());
+	return *this;
+}
+
+void bigint_accumulator::reset() noexcept
+{
+	std::free(data_);
+
+	data_ = nullptr;
+	capacity_ = 0;
+	pending_ = 0;
+}
+void bigint_accumulator::swap(bigint_accumulator& accumulator) noexcept
+{
+	if (this == &accumulator) return;
+
+	std::swap(data_, accumulator.data_);
+	std::swap(capacity_, accumulator.capacity_);
+	std::swap(pending_, accumulator.pending_);
+}
+
+void bigint_accumulator::reserve(size_type new_capacity)
+{
+	if (new_capacity > capacity_)
+	{
+		block_type* const new_data = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * new_capacity));
+
+		if (!new_data) throw std::bad_alloc();
+
+		std::fill(new_data + capacity_, new_data + new_capacity, 0);
+
+		if (data_)
+		{
+			_BIGNUM_STATS_REALLOCATE(accumulator, sizeof(block_type) * new_capacity);
+		}
+		else
+		{
+			_BIGNUM_STATS_ALLOCATE(accumulator, sizeof(block_type) * new_capacity);
+		}
+
+		data_ = new_data;
+		capacity_ = new_capacity;
+	}
+}
+void bigint_accumulator::normalize()
+{
+	if (!capacity_) return;
+
+	block_type carry = 0;
+
+	for (size_type i = 0; i < capacity_ - 1; ++i)
+	{
+		const block_type block = data_[i] + carry;
+
+		data_[i] = block & 0xFFFFFFFF;
+		carry = block >> 32;
+	}
+
+	data_[capacity_ - 1] += carry;
+
+	// The highest limb keeps the sign of the total; split it before it eats into the headroom of later additions.
+	if (data_[capacity_ - 1] >= (static_cast<block_type>(1) << 31) || data_[capacity_ - 1] < -(static_cast<block_type>(1) << 31))
+	{
+		reserve(capacity_ + 1);
+
+		data_[capacity_ - 1] = data_[capacity_ - 2] >> 32;
+		data_[capacity_ - 2] &= 0xFFFFFFFF;
+	}
+
+	pending_ = 0;
+}
+
+bigint bigint_accumulator::value() const
+{
+	bigint result;
+
+	if (!capacity_) return result;
+
+	result.reserve_(capacity_ + 1, bigint_stats::site::accumulator);
+
+	bigint::block_type* const data = result.data_;
+	block_type carry = 0;
+
+	for (size_type i = 0; i < capacity_ - 1; ++i)
+	{
+		const block_type block = data_[i] + carry;
+
+		data[i] = static_cast<bigint::block_type>(block & 0xFFFFFFFF);
+		carry = block >> 32;
+	}
+
+	const block_type top = data_[capacity_ - 1] + carry;
+	std::uint64_t high;
+
+	if (top >= 0)
+	{
+		high = static_cast<std::uint64_t>(top);
+	}
+	else
+	{
+		bool borrow = false;
+
+		for (size_type i = 0; i < capacity_ - 1; ++i)
+		{
+			if (data[i] || borrow)
+			{
+				data[i] = ~data[i] + !borrow;
+				borrow = true;
+			}
+		}
+
+		high = static_cast<std::uint64_t>(-(top + 1)) + !borrow;
+		result.sign_ = true;
+	}
+
+	data[capacity_ - 1] = static_cast<bigint::block_type>(high & 0xFFFFFFFF);
+	data[capacity_] = static_cast<bigint::block_type>(high >> 32);
+
+	if (result.sign_ && result.zero())
+	{
+		result.sign_ = false;
+	}
+
+	return result;
+}
+
+void bigint_accumulator::add_blocks_(const bigint::block_type* data, size_type size, bool negative)
+{
+	size = _BIGNUM_DETAILS::used_size(data, size);
+
+	_BIGNUM_STATS_OPERATION(accumulate, size);
+
+	if (!size) return;
+
+	if (pending_ == _BIGNUM_DETAILS::accumulator_headroom)
+	{
+		normalize();
+	}
+
+	reserve(size + 1);
+
+	if (negative)
+	{
+		for (size_type i = 0; i < size; ++i)
+		{
+			data_[i] -= data[i];
+		}
+	}
+	else
+	{
+		for (size_type i = 0; i < size; ++i)
+		{
+			data_[i] += data[i];
+		}
+	}
+
+	++pending_;
+}
+
+const bigint_accumulator::block_type* bigint_accumulator::data() const noexcept
+{
+	return data_;
+}
+bigint_accumulator::size_type bigint_accumulator::capacity() const noexcept
+{
+	return capacity_;
+}
+bigint_accumulator::size_type bigint_accumulator::pending() const noexcept
+{
+	return pending_;
+}
+
+struct bigint_concurrent_accumulator::buffer_
+{
+	std::atomic<std::int64_t>* data;
+	size_type capacity;
+	buffer_* retired;
+};
+
+struct bigint_concurrent_accumulator::shard_
+{
+	std::shared_ptr<std::atomic<bool>> abandoned;
+	shard_* next;
+	size_type pending;
+
+	// Seqlock: odd while the owner is writing, readers retry when it changed under them.
+	std::atomic<std::uint64_t> sequence;
+	std::atomic<buffer_*> buffer;
+
+	char padding[64];
+};
+
+bigint_concurrent_accumulator::bigint_concurrent_accumulator()
+	: id_(_BIGNUM_DETAILS::concurrent_accumulator_id.fetch_add(1, std::memory_order_relaxed)), shards_(nullptr), readers_(0)
+{}
+bigint_concurrent_accumulator::~bigint_concurrent_accumulator()
+{
+	shard_* shard = shards_.load(std::memory_order_acquire);
+
+	while (shard)
+	{
+		buffer_* buffer = shard->buffer.load(std::memory_order_relaxed);
+
+		while (buffer)
+		{
+			buffer_* const retired = buffer->retired;
+
+			delete[] buffer->data;
+			delete buffer;
+
+			buffer = retired;
+		}
+
+		shard_* const next = shard->next;
+
+		delete shard;
+
+		shard = next;
+	}
+}
+
+bigint_concurrent_accumulator& bigint_concurrent_accumulator::operator+=(const bigint_view& integer)
+{
+	add_blocks_(integer.data(), integer.capacity(), integer.sign());
+	return *this;
+}
+bigint_concurrent_accumulator& bigint_concurrent_accumulator::operator-=(const bigint_view& integer)
+{
+	add_blocks_(integer.data(), integer.capacity(), !integer.sign());
+	return *this;
+}
+
+bigint bigint_concurrent_accumulator::value() const
+{
+	const _BIGNUM_DETAILS::concurrent_accumulator_reader reader(readers_);
+	bigint_accumulator total;
+	bigint_accumulator snapshot;
+
+	for (shard_* shard = shards_.load(std::memory_order_acquire); shard; shard = shard->next)
+	{
+		for (;;)
+		{
+			const std::uint64_t sequence = shard->sequence.load(std::memory_order_acquire);
+
+			if (sequence & 1)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			const buffer_* const buffer = shard->buffer.load(std::memory_order_seq_cst);
+
+			if (!buffer) break;
+
+			snapshot.reserve(buffer->capacity);
+
+			for (size_type i = 0; i < buffer->capacity; ++i)
+			{
+				snapshot.data_[i] = buffer->data[i].load(std::memory_order_relaxed);
+			}
+			std::fill(snapshot.data_ + buffer->capacity, snapshot.data_ + snapshot.capacity_, 0);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (shard->sequence.load(std::memory_order_relaxed) == sequence)
+			{
+				total += snapshot.value();
+				break;
+			}
+		}
+	}
+
+	return total.value();
+}
+bigint_concurrent_accumulator::size_type bigint_concurrent_accumulator::shards() const noexcept
+{
+	size_type count = 0;
+
+	for (shard_* shard = shards_.load(std::memory_order_acquire); shard; shard = shard->next)
+	{
+		++count;
+	}
+
+	return count;
+}
+bigint_concurrent_accumulator::size_type bigint_concurrent_accumulator::capacity() const noexcept
+{
+	size_type capacity = 0;
+
+	const _BIGNUM_DETAILS::concurrent_accumulator_reader reader(readers_);
+
+	for (shard_* shard = shards_.load(std::memory_order_acquire); shard; shard = shard->next)
+	{
+		const buffer_* const buffer = shard->buffer.load(std::memory_order_seq_cst);
+
+		if (buffer)
+		{
+			capacity += buffer->capacity;
+		}
+	}
+
+	return capacity;
+}
+
+bigint_concurrent_accumulator::shard_* bigint_concurrent_accumulator::local_shard_()
+{
+	_BIGNUM_DETAILS::concurrent_accumulator_cache& cache = _BIGNUM_DETAILS::concurrent_accumulator_caches[id_ % 8];
+
+	if (cache.id == id_) return static_cast<shard_*>(cache.shard);
+
+	_BIGNUM_DETAILS::concurrent_accumulator_owner& owner = _BIGNUM_DETAILS::concurrent_accumulator_owners();
+	shard_* shard = static_cast<shard_*>(owner.find(id_));
+
+	if (!shard)
+	{
+		// Adopt the shard of a thread that has exited before adding a new one, so short-lived threads do not pile up shards.
+		for (shard = shards_.load(std::memory_order_acquire); shard; shard = shard->next)
+		{
+			bool abandoned = true;
+
+			if (shard->abandoned->compare_exchange_strong(abandoned, false, std::memory_order_acq_rel)) break;
+		}
+
+		if (!shard)
+		{
+			std::unique_ptr<shard_> new_shard(new shard_());
+
+			new_shard->abandoned = std::make_shared<std::atomic<bool>>(false);
+			new_shard->pending = 0;
+			new_shard->sequence.store(0, std::memory_order_relaxed);
+			new_shard->buffer.store(nullptr, std::memory_order_relaxed);
+
+			std::lock_guard<std::mutex> guard(mutex_);
+
+			shard = new_shard.release();
+			shard->next = shards_.load(std::memory_order_relaxed);
+
+			shards_.store(shard, std::memory_order_release);
+		}
+
+		try
+		{
+			owner.add(id_, shard, shard->abandoned);
+		}
+		catch (...)
+		{
+			shard->abandoned->store(true, std::memory_order_release);
+			throw;
+		}
+	}
+
+	cache.id = id_;
+	cache.shard = shard;
+
+	return shard;
+}
+void bigint_concurrent_accumulator::add_blocks_(const bigint::block_type* data, size_type size, bool negative)
+{
+	size = _BIGNUM_DETAILS::used_size(data, size);
+
+	_BIGNUM_STATS_OPERATION(accumulate, size);
+
+	if (!size) return;
+
+	shard_* const shard = local_shard_();
+	buffer_* buffer = shard->buffer.load(std::memory_order_relaxed);
+
+	if (!buffer)
+	{
+		buffer = grow_(shard, size + 1, false);
+	}
+	else if (buffer->capacity < size + 1)
+	{
+		buffer = grow_(shard, std::max(size + 1, buffer->capacity + buffer->capacity / 2), false);
+	}
+
+	std::atomic<std::int64_t>* const limbs = buffer->data;
+	const size_type top = buffer->capacity - 1;
+	const std::uint64_t sequence = shard->sequence.load(std::memory_order_relaxed);
+
+	shard->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	bool split = false;
+
+	if (shard->pending == _BIGNUM_DETAILS::accumulator_headroom)
+	{
+		std::int64_t carry = 0;
+
+		for (size_type i = 0; i < top; ++i)
+		{
+			const std::int64_t block = limbs[i].load(std::memory_order_relaxed) + carry;
+
+			limbs[i].store(block & 0xFFFFFFFF, std::memory_order_relaxed);
+			carry = block >> 32;
+		}
+
+		const std::int64_t block = limbs[top].load(std::memory_order_relaxed) + carry;
+
+		limbs[top].store(block, std::memory_order_relaxed);
+		split = block < -(static_cast<std::int64_t>(1) << 31) || block >= (static_cast<std::int64_t>(1) << 31);
+		shard->pending = 0;
+	}
+
+	if (negative)
+	{
+		for (size_type i = 0; i < size; ++i)
+		{
+			limbs[i].store(limbs[i].load(std::memory_order_relaxed) - data[i], std::memory_order_relaxed);
+		}
+	}
+	else
+	{
+		for (size_type i = 0; i < size; ++i)
+		{
+			limbs[i].store(limbs[i].load(std::memory_order_relaxed) + data[i], std::memory_order_relaxed);
+		}
+	}
+
+	shard->sequence.store(sequence + 2, std::memory_order_release);
+	++shard->pending;
+
+	// Like bigint_accumulator::normalize, the top limb only needs a limb of its own once it leaves 32 bits.
+	if (split)
+	{
+		grow_(shard, buffer->capacity + 1, true);
+	}
+}
+bigint_concurrent_accumulator::buffer_* bigint_concurrent_accumulator::grow_(shard_* shard, size_type new_capacity, bool split)
+{
+	buffer_* const buffer = shard->buffer.load(std::memory_order_relaxed);
+	buffer_* const new_buffer = new buffer_();
+
+	try
+	{
+		new_buffer->data = new std::atomic<std::int64_t>[new_capacity];
+	}
+	catch (...)
+	{
+		delete new_buffer;
+		throw;
+	}
+
+	new_buffer->capacity = new_capacity;
+	new_buffer->retired = buffer;
+
+	if (buffer)
+	{
+		_BIGNUM_STATS_REALLOCATE(accumulator, sizeof(std::int64_t) * new_capacity);
+	}
+	else
+	{
+		_BIGNUM_STATS_ALLOCATE(accumulator, sizeof(std::int64_t) * new_capacity);
+	}
+
+	const size_type old_capacity = buffer ? buffer->capacity : 0;
+
+	for (size_type i = 0; i < old_capacity; ++i)
+	{
+		new_buffer->data[i].store(buffer->data[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+	for (size_type i = old_capacity; i < new_capacity; ++i)
+	{
+		new_buffer->data[i].store(0, std::memory_order_relaxed);
+	}
+
+	if (split)
+	{
+		const std::int64_t block = new_buffer->data[old_capacity - 1].load(std::memory_order_relaxed);
+
+		new_buffer->data[old_capacity].store(block >> 32, std::memory_order_relaxed);
+		new_buffer->data[old_capacity - 1].store(block & 0xFFFFFFFF, std::memory_order_relaxed);
+	}
+
+	// Readers register in readers_ before loading a buffer, so with both sides sequentially consistent either they see
+	// the new buffer or the count below sees them, and the retired buffers are kept until a growth with no reader around.
+	shard->buffer.store(new_buffer, std::memory_order_seq_cst);
+
+	if (readers_.load(std::memory_order_seq_cst) == 0)
+	{
+		buffer_* retired = new_buffer->retired;
+
+		while (retired)
+		{
+			buffer_* const next = retired->retired;
+
+			delete[] retired->data;
+			delete retired;
+
+			retired = next;
+		}
+
+		new_buffer->retired = nullptr;
+	}
+
+	return new_buffer;
+}
+
+struct bigint_handle::shared_
+{
+	std::atomic<size_type> count;
+	bigint value;
+};
+
+bigint_handle::bigint_handle(const bigint& integer)
+	: block_(new shared_{ { 1 }, integer })
+{}
+bigint_handle::bigint_handle(bigint&& integer)
+	: block_(new shared_{ { 1 }, std::move(integer) })
+{}
+bigint_handle::bigint_handle(const bigint_handle& handle) noexcept
+	: block_(handle.block_)
+{
+	if (block_)
+	{
+		block_->count.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+bigint_handle::bigint_handle(bigint_handle&& handle) noexcept
+	: block_(handle.block_)
+{
+	handle.block_ = nullptr;
+}
+bigint_handle::~bigint_handle()
+{
+	release_();
+}
+
+bigint_handle& bigint_handle::operator=(const bigint_handle& handle) noexcept
+{
+	if (block_ == handle.block_) return *this;
+
+	if (handle.block_)
+	{
+		handle.block_->count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	release_();
+	block_ = handle.block_;
+
+	return *this;
+}
+bigint_handle& bigint_handle::operator=(bigint_handle&& handle) noexcept
+{
+	if (this == &handle) return *this;
+
+	release_();
+	block_ = handle.block_;
+	handle.block_ = nullptr;
+
+	return *this;
+}
+const bigint& bigint_handle::operator*() const noexcept
+{
+	return get();
+}
+const bigint* bigint_handle::operator->() const noexcept
+{
+	return &get();
+}
+bigint_handle::operator const bigint&() const noexcept
+{
+	return get();
+}
+
+void bigint_handle::reset() noexcept
+{
+	release_();
+	block_ = nullptr;
+}
+void bigint_handle::swap(bigint_handle& handle) noexcept
+{
+	std::swap(block_, handle.block_);
+}
+
+const bigint& bigint_handle::get() const noexcept
+{
+	static const bigint empty;
+
+	return block_ ? block_->value : empty;
+}
+bigint& bigint_handle::mutate()
+{
+	if (!block_)
+	{
+		block_ = new shared_{ { 1 }, bigint() };
+	}
+	else if (block_->count.load(std::memory_order_acquire) != 1)
+	{
+		shared_* const copy = new shared_{ { 1 }, block_->value };
+
+		release_();
+		block_ = copy;
+	}
+
+	return block_->value;
+}
+
+bool bigint_handle::unique() const noexcept
+{
+	return block_ && block_->count.load(std::memory_order_acquire) == 1;
+}
+bigint_handle::size_type bigint_handle::use_count() const noexcept
+{
+	return block_ ? block_->count.load(std::memory_order_acquire) : 0;
+}
+
+void bigint_handle::release_() noexcept
+{
+	if (block_ && block_->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		delete block_;
+	}
+}
+
+// Pairs neighbouring nodes level by level, so the products on each level are of matching sizes.
+// A node without a partner is carried up unchanged.
+bigint_product_tree::bigint_product_tree(const bigint* integers, size_type size, unsigned threads)
+{
+	if (!size) return;
+
+	levels_.emplace_back(integers, integers + size);
+
+	while (levels_.back().size() > 1)
+	{
+		const std::vector<bigint>& children = levels_.back();
+		std::vector<bigint> parents((children.size() + 1) / 2);
+
+		_BIGNUM_DETAILS::parallel_for(parents.size(), _BIGNUM_DETAILS::thread_count(threads, parents.size()), [&](std::size_t index, unsigned)
+		{
+			if (index * 2 + 1 < children.size())
+			{
+				parents[index] = children[index * 2] * children[index * 2 + 1];
+			}
+			else
+			{
+				parents[index] = children[index * 2];
+			}
+		});
+
+		levels_.push_back(std::move(parents));
+	}
+}
+bigint_product_tree::bigint_product_tree(const std::vector<bigint>& integers, unsigned threads)
+	: bigint_product_tree(integers.data(), integers.size(), threads)
+{}
+
+void bigint_product_tree::reset() noexcept
+{
+	levels_.clear();
+}
+void bigint_product_tree::swap(bigint_product_tree& tree) noexcept
+{
+	levels_.swap(tree.levels_);
+}
+
+// Returns integer % leaf for every leaf, reducing down the tree so each division
+// works on operands about the size of its node.
+std::vector<bigint> bigint_product_tree::remainders(const bigint_view& integer, unsigned threads) const
+{
+	return remainders_(integer, false, threads);
+}
+// Bernstein's batch GCD: for each integer, its GCD with the product of all the others.
+std::vector<bigint> bigint_product_tree::batch_gcd(const bigint* integers, size_type size, unsigned threads)
+{
+	const bigint_product_tree tree(integers, size, threads);
+
+	if (!size) return {};
+
+	std::vector<bigint> result = tree.remainders_(tree.product(), true, threads);
+
+	_BIGNUM_DETAILS::parallel_for(size, _BIGNUM_DETAILS::thread_count(threads, size), [&](std::size_t index, unsigned)
+	{
+		result[index] = bigint::gcd(result[index] / integers[index], integers[index]);
+	});
+
+	return result;
+}
+std::vector<bigint> bigint_product_tree::batch_gcd(const std::vector<bigint>& integers, unsigned threads)
+{
+	return batch_gcd(integers.data(), integers.size(), threads);
+}
+
+bool bigint_product_tree::empty() const noexcept
+{
+	return levels_.empty();
+}
+bigint_product_tree::size_type bigint_product_tree::size() const noexcept
+{
+	return levels_.empty() ? 0 : levels_.front().size();
+}
+bigint_product_tree::size_type bigint_product_tree::levels() const noexcept
+{
+	return levels_.size();
+}
+const std::vector<bigint>& bigint_product_tree::level(size_type index) const
+{
+	if (index >= levels_.size()) throw std::out_of_range("index >= levels()");
+
+	return levels_[index];
+}
+const bigint& bigint_product_tree::product() const
+{
+	static const bigint one(1);
+
+	return levels_.empty() ? one : levels_.back().front();
+}
+
+// With squared set, each node is reduced modulo the square of its value instead.
+std::vector<bigint> bigint_product_tree::remainders_(const bigint_view& integer, bool squared, unsigned threads) const
+{
+	if (levels_.empty()) return {};
+
+	std::vector<bigint> current(1, bigint(integer));
+
+	for (size_type i = levels_.size(); i-- > 0;)
+	{
+		const std::vector<bigint>& nodes = levels_[i];
+		std::vector<bigint> next(nodes.size());
+
+		_BIGNUM_DETAILS::parallel_for(nodes.size(), _BIGNUM_DETAILS::thread_count(threads, nodes.size()), [&](std::size_t index, unsigned)
+		{
+			const bigint& parent = current[i + 1 == levels_.size() ? 0 : index / 2];
+
+			next[index] = squared ? parent % (nodes[index] * nodes[index]) : parent % nodes[index];
+		});
+
+		current.swap(next);
+	}
+
+	return current;
+}
+
+constexpr bigfloat::size_type bigfloat::default_precision;
+
+bigfloat::bigfloat(const bigint_view& mantissa, exponent_type exponent, size_type precision, rounding mode)
+	: mantissa_(mantissa), exponent_(exponent), precision_(precision), mode_(mode)
+{
+	if (!precision) throw std::invalid_argument("precision == 0");
+
+	round_(precision, mode, false);
+}
+bigfloat::bigfloat(double value, size_type precision, rounding mode)
+	: precision_(precision), mode_(mode)
+{
+	if (!precision) throw std::invalid_argument("precision == 0");
+	else if (!std::isfinite(value)) throw std::invalid_argument("!isfinite(value)");
+
+	int exponent = 0;
+	const std::int64_t mantissa = static_cast<std::int64_t>(std::ldexp(std::frexp(value, &exponent), 53));
+
+	mantissa_ = bigint(mantissa);
+	exponent_ = exponent - 53;
+
+	round_(precision, mode, false);
+}
+
+bool bigfloat::operator==(const bigfloat& value) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, value) == 0;
+}
+bool bigfloat::operator!=(const bigfloat& value) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, value) != 0;
+}
+bool bigfloat::operator>(const bigfloat& value) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, value) > 0;
+}
+bool bigfloat::operator>=(const bigfloat& value) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, value) >= 0;
+}
+bool bigfloat::operator<(const bigfloat& value) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, value) < 0;
+}
+bool bigfloat::operator<=(const bigfloat& value) const noexcept
+{
+	return _BIGNUM_DETAILS::compare(*this, value) <= 0;
+}
+// The operators round to the larger of the two precisions, in the rounding mode of the left operand.
+bigfloat bigfloat::operator+(const bigfloat& value) const
+{
+	return add(*this, value, std::max(precision_, value.precision_), mode_);
+}
+bigfloat& bigfloat::operator+=(const bigfloat& value)
+{
+	bigfloat result = *this + value;
+
+	swap(result);
+
+	return *this;
+}
+bigfloat bigfloat::operator-(const bigfloat& value) const
+{
+	return sub(*this, value, std::max(precision_, value.precision_), mode_);
+}
+bigfloat& bigfloat::operator-=(const bigfloat& value)
+{
+	bigfloat result = *this - value;
+
+	swap(result);
+
+	return *this;
+}
+bigfloat bigfloat::operator*(const bigfloat& value) const
+{
+	return mul(*this, value, std::max(precision_, value.precision_), mode_);
+}
+bigfloat& bigfloat::operator*=(const bigfloat& value)
+{
+	bigfloat result = *this * value;
+
+	swap(result);
+
+	return *this;
+}
+bigfloat bigfloat::operator/(const bigfloat& value) const
+{
+	return div(*this, value, std::max(precision_, value.precision_), mode_);
+}
+bigfloat& bigfloat::operator/=(const bigfloat& value)
+{
+	bigfloat result = *this / value;
+
+	swap(result);
+
+	return *this;
+}
+bigfloat bigfloat::operator-() const
+{
+	bigfloat result(*this);
+
+	if (!zero())
+	{
+		result.mantissa_ = bigint(-bigint_view(mantissa_));
+	}
+
+	return result;
+}
+bool bigfloat::operator!() const noexcept
+{
+	return zero();
+}
+bigfloat::operator bool() const noexcept
+{
+	return !zero();
+}
+
+void bigfloat::swap(bigfloat& value) noexcept
+{
+	mantissa_.swap(value.mantissa_);
+	std::swap(exponent_, value.exponent_);
+	std::swap(precision_, value.precision_);
+	std::swap(mode_, value.mode_);
+}
+
+bigfloat bigfloat::add(const bigfloat& a, const bigfloat& b, size_type precision, rounding mode)
+{
+	if (!precision) throw std::invalid_argument("precision == 0");
+
+	bigfloat result;
+
+	result.precision_ = precision;
+	result.mode_ = mode;
+
+	if (a.zero() || b.zero())
+	{
+		const bigfloat& value = a.zero() ? b : a;
+
+		result.mantissa_ = value.mantissa_;
+		result.exponent_ = value.exponent_;
+		result.round_(precision, mode, false);
+
+		return result;
+	}
+
+	const exponent_type a_top = a.exponent_ + static_cast<exponent_type>(_BIGNUM_DETAILS::bit_length(a.mantissa_));
+	const exponent_type b_top = b.exponent_ + static_cast<exponent_type>(_BIGNUM_DETAILS::bit_length(b.mantissa_));
+	const bigfloat& large = a_top >= b_top ? a : b;
+	const bigfloat& small = a_top >= b_top ? b : a;
+	const exponent_type bottom = std::min(large.exponent_, std::max(a_top, b_top) - static_cast<exponent_type>(precision) - 3);
+
+	if (std::min(a_top, b_top) <= bottom)
+	{
+		// The smaller operand lies wholly below the rounding position and only decides the direction,
+		// so it is replaced by one unit two bits below it instead of being aligned.
+		result.mantissa_ = large.mantissa_ << static_cast<size_type>(large.exponent_ - bottom + 2);
+		result.mantissa_ += bigint(small.negative() ? -1 : 1);
+		result.exponent_ = bottom - 2;
+	}
+	else if (a.exponent_ >= b.exponent_)
+	{
+		result.mantissa_ = a.mantissa_ << static_cast<size_type>(a.exponent_ - b.exponent_);
+		result.mantissa_ += b.mantissa_;
+		result.exponent_ = b.exponent_;
+	}
+	else
+	{
+		result.mantissa_ = b.mantissa_ << static_cast<size_type>(b.exponent_ - a.exponent_);
+		result.mantissa_ += a.mantissa_;
+		result.exponent_ = a.exponent_;
+	}
+
+	result.round_(precision, mode, false);
+
+	return result;
+}
+bigfloat bigfloat::sub(const bigfloat& a, const bigfloat& b, size_type precision, rounding mode)
+{
+	return add(a, -b, precision, mode);
+}
+// Operands wider than the result are cut to precision plus a guard block before multiplying, so no work
+// is spent on bits the rounding would discard. The cut product only brackets the exact one; when the two
+// ends of the bracket round apart, which the guard block makes rare, the full mantissas are multiplied.
+bigfloat bigfloat::mul(const bigfloat& a, const bigfloat& b, size_type precision, rounding mode)
+{
+	if (!precision) throw std::invalid_argument("precision == 0");
+
+	bigfloat result;
+
+	result.precision_ = precision;
+	result.mode_ = mode;
+
+	if (a.zero() || b.zero()) return result;
+
+	const size_type limit = precision + 32;
+	const bool negative = a.negative() != b.negative();
+	const bigint* const mantissas[2] = { &a.mantissa_, &b.mantissa_ };
+	bigint low[2], high[2];
+	exponent_type exponent = a.exponent_ + b.exponent_;
+	bool sticky = false;
+
+	for (int i = 0; i < 2; ++i)
+	{
+		const size_type bits = _BIGNUM_DETAILS::bit_length(*mantissas[i]);
+		const size_type shift = bits > limit ? bits - limit : 0;
+
+		low[i] = bigint(bigint_view(mantissas[i]->data(), mantissas[i]->capacity())) >> shift;
+		high[i] = low[i];
+
+		if (shift && _BIGNUM_DETAILS::test_bits(*mantissas[i], shift))
+		{
+			sticky = true;
+			++high[i];
+		}
+
+		exponent += static_cast<exponent_type>(shift);
+	}
+
+	result.mantissa_ = low[0] * low[1];
+	result.exponent_ = exponent;
+
+	if (negative)
+	{
+		result.mantissa_ = bigint(-bigint_view(result.mantissa_));
+	}
+
+	result.round_(precision, mode, sticky);
+
+	if (!sticky) return result;
+
+	// The exact magnitude lies in [low[0] * low[1], high[0] * high[1]), and rounding is monotonic.
+	bigfloat bound;
+
+	bound.mantissa_ = high[0] * high[1];
+	bound.mantissa_ -= bigint(1);
+	bound.exponent_ = exponent;
+
+	if (negative)
+	{
+		bound.mantissa_ = bigint(-bigint_view(bound.mantissa_));
+	}
+
+	bound.round_(precision, mode, true);
+
+	if (bound.mantissa_ == result.mantissa_ && bound.exponent_ == result.exponent_) return result;
+
+	result.mantissa_ = a.mantissa_ * b.mantissa_;
+	result.exponent_ = a.exponent_ + b.exponent_;
+	result.round_(precision, mode, false);
+
+	return result;
+}
+bigfloat bigfloat::div(const bigfloat& a, const bigfloat& b, size_type precision, rounding mode)
+{
+	if (!precision) throw std::invalid_argument("precision == 0");
+	else if (b.zero()) throw std::invalid_argument("divisor == 0");
+
+	bigfloat result;
+
+	result.precision_ = precision;
+	result.mode_ = mode;
+
+	if (a.zero()) return result;
+
+	// The quotient gets at least two bits beyond the precision, and the remainder becomes the sticky bit.
+	const size_type a_bits = _BIGNUM_DETAILS::bit_length(a.mantissa_);
+	const size_type b_bits = _BIGNUM_DETAILS::bit_length(b.mantissa_);
+	const size_type shift = precision + 2 + b_bits > a_bits ? precision + 2 + b_bits - a_bits : 0;
+
+	bigint remainder;
+
+	bigint::divmod(a.mantissa_ << shift, b.mantissa_, result.mantissa_, remainder);
+
+	result.exponent_ = a.exponent_ - static_cast<exponent_type>(shift) - b.exponent_;
+	result.round_(precision, mode, !remainder.zero());
+
+	return result;
+}
+bigfloat bigfloat::sqrt(const bigfloat& a, size_type precision, rounding mode)
+{
+	if (!precision) throw std::invalid_argument("precision == 0");
+	else if (a.negative()) throw std::invalid_argument("value < 0");
+
+	bigfloat result;
+
+	result.precision_ = precision;
+	result.mode_ = mode;
+
+	if (a.zero()) return result;
+
+	// Scales the mantissa by an even power of two so the integer root has at least two bits beyond the precision.
+	const size_type bits = _BIGNUM_DETAILS::bit_length(a.mantissa_);
+	size_type shift = precision * 2 + 4 > bits ? precision * 2 + 4 - bits : 0;
+
+	if ((a.exponent_ - static_cast<exponent_type>(shift)) % 2)
+	{
+		++shift;
+	}
+
+	const bigint scaled = a.mantissa_ << shift;
+
+	result.mantissa_ = _BIGNUM_DETAILS::isqrt(scaled);
+	result.exponent_ = (a.exponent_ - static_cast<exponent_type>(shift)) / 2;
+	result.round_(precision, mode, result.mantissa_ * result.mantissa_ != scaled);
+
+	return result;
+}
+bigfloat bigfloat::sqrt() const
+{
+	return sqrt(*this, precision_, mode_);
+}
+
+bool bigfloat::zero() const noexcept
+{
+	return mantissa_.zero();
+}
+bool bigfloat::positive() const noexcept
+{
+	return mantissa_.positive();
+}
+bool bigfloat::negative() const noexcept
+{
+	return mantissa_.negative();
+}
+
+void bigfloat::set_precision(size_type precision)
+{
+	if (!precision) throw std::invalid_argument("precision == 0");
+
+	round_(precision, mode_, false);
+	precision_ = precision;
+}
+void bigfloat::set_mode(rounding mode) noexcept
+{
+	mode_ = mode;
+}
+
+// Truncates toward zero.
+bigint bigfloat::to_bigint() const
+{
+	if (exponent_ >= 0) return mantissa_ << static_cast<size_type>(exponent_);
+
+	bigint result = bigint(bigint_view(mantissa_.data(), mantissa_.capacity())) >> static_cast<size_type>(-exponent_);
+
+	return negative() && !result.zero() ? bigint(-bigint_view(result)) : result;
+}
+double bigfloat::to_double() const noexcept
+{
+	const size_type bits = _BIGNUM_DETAILS::bit_length(mantissa_);
+	const size_type shift = bits > 64 ? bits - 64 : 0;
+	std::uint64_t top = 0;
+
+	for (size_type i = 0; i < 64 && shift + i < bits; i += 32)
+	{
+		top |= static_cast<std::uint64_t>(_BIGNUM_DETAILS::extract_bits(mantissa_, static_cast<std::int64_t>(shift + i))) << i;
+	}
+
+	const bool sticky = shift && _BIGNUM_DETAILS::test_bits(mantissa_, shift);
+	exponent_type exponent = exponent_ + static_cast<exponent_type>(shift);
+
+	if (exponent < -1074)
+	{
+		// A subnormal holds fewer bits than top, so round to its last bit here; ldexp would round the rounded value again.
+		const exponent_type drop = -1074 - exponent;
+
+		if (drop > 64)
+		{
+			top = 0;
+		}
+		else
+		{
+			const std::uint64_t kept = drop == 64 ? 0 : top >> drop;
+			const std::uint64_t rest = drop == 64 ? top : top & ((static_cast<std::uint64_t>(1) << drop) - 1);
+			const std::uint64_t half = static_cast<std::uint64_t>(1) << (drop - 1);
+
+			top = kept + (rest > half || (rest == half && (sticky || (kept & 1))));
+		}
+
+		exponent = -1074;
+	}
+	else if (sticky)
+	{
+		// Keeps the dropped bits as a sticky bit so the conversion to double rounds once.
+		top |= 1;
+	}
+
+	// Any exponent past 4096 overflows a double whatever top is, so the clamp only keeps the int cast in range.
+	const double magnitude = std::ldexp(static_cast<double>(top), static_cast<int>(std::min<exponent_type>(exponent, 4096)));
+
+	return negative() ? -magnitude : magnitude;
+}
+// Scientific notation with digits significant digits, truncated. Zero digits gives enough to
+// tell apart neighbouring values at the current precision.
+std::string bigfloat::to_string(size_type digits) const
+{
+	if (zero()) return "0";
+
+	if (!digits)
+	{
+		digits = precision_ * 30103 / 100000 + 2;
+	}
+
+	const exponent_type top = exponent_ + static_cast<exponent_type>(_BIGNUM_DETAILS::bit_length(mantissa_));
+	const exponent_type estimate = static_cast<exponent_type>(std::floor((top - 1) * 0.30102999566398120));
+	const exponent_type scale = static_cast<exponent_type>(digits) - 1 - estimate;
+
+	bigint power(1), ten(10);
+
+	for (exponent_type i = std::abs(scale); i; i >>= 1)
+	{
+		if (i & 1)
+		{
+			power *= ten;
+		}
+
+		ten *= ten;
+	}
+
+	bigint scaled(bigint_view(mantissa_.data(), mantissa_.capacity()));
+
+	if (scale >= 0)
+	{
+		scaled *= power;
+	}
+
+	if (exponent_ >= 0)
+	{
+		scaled <<= static_cast<size_type>(exponent_);
 	}
 	else
 	{
-		larger = &integer;
-		smaller = this;
+		scaled >>= static_cast<size_type>(-exponent_);
+	}
+
+	if (scale < 0)
+	{
+		scaled /= power;
+	}
+
+	std::string result = scaled.to_string();
+	const exponent_type exponent = static_cast<exponent_type>(result.size()) - 1 - scale;
+
+	result.resize(std::min(result.size(), static_cast<std::size_t>(digits)));
+
+	while (result.size() > 1 && result.back() == '0')
+	{
+		result.pop_back();
+	}
+
+	if (result.size() > 1)
+	{
+		result.insert(1, 1, '.');
+	}
+
+	if (exponent)
+	{
+		result += 'e' + std::to_string(exponent);
 	}
 
-	const size_type limit = smaller->capacity_;
+	return negative() ? '-' + result : result;
+}
 
-	bool result = false;
+// Rounds the mantissa to precision bits. sticky marks a nonzero tail below the mantissa, which callers
+// only pass when the mantissa is already wider than precision.
+void bigfloat::round_(size_type precision, rounding mode, bool sticky)
+{
+	const size_type bits = _BIGNUM_DETAILS::bit_length(mantissa_);
 
-	for (size_type i = larger->capacity_ - 1; i >= limit; --i)
+	if (bits > precision)
 	{
-		if (larger->data_[i])
+		const size_type shift = bits - precision;
+		const bool sign = mantissa_.negative();
+		const bool half = _BIGNUM_DETAILS::test_bit(mantissa_, shift - 1);
+
+		sticky |= _BIGNUM_DETAILS::test_bits(mantissa_, shift - 1);
+
+		bigint magnitude(bigint_view(mantissa_.data(), mantissa_.capacity()));
+
+		magnitude >>= shift;
+		exponent_ += static_cast<exponent_type>(shift);
+
+		bool increment = false;
+
+		switch (mode)
+		{
+		case rounding::nearest: increment = half && (sticky || _BIGNUM_DETAILS::test_bit(magnitude, 0)); break;
+		case rounding::toward_zero: break;
+		case rounding::away_from_zero: increment = half || sticky; break;
+		case rounding::upward: increment = !sign && (half || sticky); break;
+		case rounding::downward: increment = sign && (half || sticky); break;
+		}
+
+		if (increment)
 		{
-			result = smaller == this;
-			goto exit;
+			++magnitude;
 		}
+
+		mantissa_ = sign ? bigint(-bigint_view(magnitude)) : std::move(magnitude);
+	}
+
+	const size_type zeros = _BIGNUM_DETAILS::trailing_zeros(mantissa_);
+
+	if (zeros)
+	{
+		mantissa_ >>= zeros;
+		exponent_ += static_cast<exponent_type>(zeros);
+	}
+	else if (mantissa_.zero())
+	{
+		exponent_ = 0;
+	}
+}
+
+const bigint& bigfloat::mantissa() const noexcept
+{
+	return mantissa_;
+}
+bigfloat::exponent_type bigfloat::exponent() const noexcept
+{
+	return exponent_;
+}
+bigfloat::size_type bigfloat::precision() const noexcept
+{
+	return precision_;
+}
+bigfloat::rounding bigfloat::mode() const noexcept
+{
+	return mode_;
+}
+
+bigrational::bigrational()
+	: denominator_(1)
+{}
+bigrational::bigrational(const bigint_view& integer)
+	: numerator_(integer), denominator_(1)
+{}
+// Fractions are stored as given and reduced only when needed.
+bigrational::bigrational(const bigint_view& numerator, const bigint_view& denominator)
+	: numerator_(numerator), denominator_(denominator), normalized_(_BIGNUM_DETAILS::unit(numerator) || _BIGNUM_DETAILS::unit(denominator))
+{
+	if (denominator_.zero()) throw std::invalid_argument("denominator == 0");
+
+	if (denominator_.negative())
+	{
+		denominator_.sign_ = false;
+		numerator_.sign_ = !numerator_.sign_;
 	}
 
-	for (size_type i = limit - 1; i >= 0; --i)
+	if (numerator_.zero())
+	{
+		numerator_.sign_ = false;
+		denominator_ = 1;
+		normalized_ = true;
+	}
+}
+
+bool bigrational::operator==(const bigrational& value) const
+{
+	return compare_(value) == 0;
+}
+bool bigrational::operator!=(const bigrational& value) const
+{
+	return compare_(value) != 0;
+}
+bool bigrational::operator>(const bigrational& value) const
+{
+	return compare_(value) > 0;
+}
+bool bigrational::operator>=(const bigrational& value) const
+{
+	return compare_(value) >= 0;
+}
+bool bigrational::operator<(const bigrational& value) const
+{
+	return compare_(value) < 0;
+}
+bool bigrational::operator<=(const bigrational& value) const
+{
+	return compare_(value) <= 0;
+}
+// With both operands in lowest terms, Henrici's method takes the GCD of the denominators and then of
+// the sum with that GCD, and the result stays in lowest terms. Otherwise no GCD is taken at all.
+bigrational bigrational::operator+(const bigrational& value) const
+{
+	bigrational result;
+
+	if (normalized_ && value.normalized_)
 	{
-		if (data_[i] < integer.data_[i])
+		const bigint gcd = _BIGNUM_DETAILS::cancel_gcd(denominator_, value.denominator_);
+
+		if (_BIGNUM_DETAILS::unit(gcd))
+		{
+			result.numerator_ = numerator_ * value.denominator_ + value.numerator_ * denominator_;
+			result.denominator_ = denominator_ * value.denominator_;
+		}
+		else
 		{
-			result = true;
-			goto exit;
+			const bigint denominator = denominator_ / gcd;
+			const bigint sum = numerator_ * (value.denominator_ / gcd) + value.numerator_ * denominator;
+			const bigint cancelled = _BIGNUM_DETAILS::cancel_gcd(sum, gcd);
+
+			result.numerator_ = _BIGNUM_DETAILS::cancel(sum, cancelled);
+			result.denominator_ = denominator * _BIGNUM_DETAILS::cancel(value.denominator_, cancelled);
 		}
-		else if (data_[i] > integer.data_[i])
+	}
+	else
+	{
+		if (denominator_ == value.denominator_)
 		{
-			result = false;
-			goto exit;
+			result.numerator_ = numerator_ + value.numerator_;
+			result.denominator_ = denominator_;
 		}
-		else if (i == 0)
+		else
 		{
-			return false;
+			result.numerator_ = numerator_ * value.denominator_ + value.numerator_ * denominator_;
+			result.denominator_ = denominator_ * value.denominator_;
 		}
+
+		result.normalized_ = false;
+		result.grow_();
+	}
+
+	return result;
+}
+bigrational& bigrational::operator+=(const bigrational& value)
+{
+	bigrational result = *this + value;
+
+	swap(result);
+
+	return *this;
+}
+bigrational bigrational::operator-(const bigrational& value) const
+{
+	return *this + -value;
+}
+bigrational& bigrational::operator-=(const bigrational& value)
+{
+	bigrational result = *this - value;
+
+	swap(result);
+
+	return *this;
+}
+// Henrici's method again: cancelling each numerator against the other denominator keeps every
+// GCD and product on the smaller pieces, and the result in lowest terms.
+bigrational bigrational::operator*(const bigrational& value) const
+{
+	bigrational result;
+
+	if (zero() || value.zero()) return result;
+	else if (normalized_ && value.normalized_)
+	{
+		const bigint first = _BIGNUM_DETAILS::cancel_gcd(numerator_, value.denominator_);
+		const bigint second = _BIGNUM_DETAILS::cancel_gcd(value.numerator_, denominator_);
+
+		result.numerator_ = _BIGNUM_DETAILS::cancel(numerator_, first) * _BIGNUM_DETAILS::cancel(value.numerator_, second);
+		result.denominator_ = _BIGNUM_DETAILS::cancel(denominator_, second) * _BIGNUM_DETAILS::cancel(value.denominator_, first);
+	}
+	else
+	{
+		result.numerator_ = numerator_ * value.numerator_;
+		result.denominator_ = denominator_ * value.denominator_;
+		result.normalized_ = false;
+		result.grow_();
+	}
+
+	return result;
+}
+bigrational& bigrational::operator*=(const bigrational& value)
+{
+	bigrational result = *this * value;
+
+	swap(result);
+
+	return *this;
+}
+bigrational bigrational::operator/(const bigrational& value) const
+{
+	if (value.zero()) throw std::invalid_argument("divisor == 0");
+
+	bigrational reciprocal;
+
+	reciprocal.numerator_ = value.denominator_;
+	reciprocal.denominator_ = value.numerator_;
+	reciprocal.numerator_.sign_ = value.numerator_.sign_;
+	reciprocal.denominator_.sign_ = false;
+	reciprocal.normalized_ = value.normalized_;
+
+	return *this * reciprocal;
+}
+bigrational& bigrational::operator/=(const bigrational& value)
+{
+	bigrational result = *this / value;
+
+	swap(result);
+
+	return *this;
+}
+bigrational bigrational::operator-() const
+{
+	bigrational result(*this);
+
+	result.numerator_.sign_ = !zero() && !numerator_.sign_;
+
+	return result;
+}
+bool bigrational::operator!() const noexcept
+{
+	return zero();
+}
+bigrational::operator bool() const noexcept
+{
+	return !zero();
+}
+
+void bigrational::swap(bigrational& value) noexcept
+{
+	numerator_.swap(value.numerator_);
+	denominator_.swap(value.denominator_);
+	std::swap(normalized_, value.normalized_);
+}
+
+void bigrational::normalize()
+{
+	if (normalized_) return;
+
+	const bigint gcd = _BIGNUM_DETAILS::cancel_gcd(numerator_, denominator_);
+
+	if (!_BIGNUM_DETAILS::unit(gcd))
+	{
+		numerator_ /= gcd;
+		denominator_ /= gcd;
 	}
 
-exit:
-	return sign_ ? !result : result;
+	if (numerator_.zero())
+	{
+		numerator_.sign_ = false;
+		denominator_ = 1;
+	}
+
+	normalized_ = true;
+}
+bool bigrational::normalized() const noexcept
+{
+	return normalized_;
+}
+
+bool bigrational::zero() const noexcept
+{
+	return numerator_.zero();
+}
+bool bigrational::positive() const noexcept
+{
+	return numerator_.positive();
+}
+bool bigrational::negative() const noexcept
+{
+	return numerator_.negative() && !numerator_.zero();
+}
+
+bigfloat bigrational::to_bigfloat(bigfloat::size_type precision, bigfloat::rounding mode) const
+{
+	const bigfloat numerator(numerator_, 0, std::max<size_type>(_BIGNUM_DETAILS::bit_length(numerator_), 1));
+	const bigfloat denominator(denominator_, 0, std::max<size_type>(_BIGNUM_DETAILS::bit_length(denominator_), 1));
+
+	return bigfloat::div(numerator, denominator, precision, mode);
 }
-bool bigint::operator<=(const bigint& integer) const noexcept
+std::string bigrational::to_string() const
 {
-	if (!capacity_)
-	{
-		if (!integer.capacity_ || integer.zero()) return true;
-		else return !integer.sign_;
-	}
-	else if (!integer.capacity_)
-	{
-		if (zero()) return true;
-		else return sign_;
-	}
-	else if (sign_ != integer.sign_)
-	{
-		const bool this_zero = zero();
-		const bool integer_zero = integer.zero();
+	bigrational value(*this);
 
-		if (!this_zero && !integer_zero) return sign_ > integer.sign_;
-		else if (this_zero && !integer_zero) return !integer.sign_;
-		else if (!this_zero && integer_zero) return sign_;
-		else return true;
-	}
+	value.normalize();
+
+	return _BIGNUM_DETAILS::unit(value.denominator_) ? value.numerator_.to_string() : value.numerator_.to_string() + '/' + value.denominator_.to_string();
+}
 
-	const bigint* smaller;
-	const bigint* larger;
+// Cross-multiplies, so comparing never needs either side in lowest terms.
+int bigrational::compare_(const bigrational& value) const
+{
+	if (negative() != value.negative()) return negative() ? -1 : 1;
+	else if (denominator_ == value.denominator_) return _BIGNUM_DETAILS::compare(numerator_, value.numerator_);
 
-	if (capacity_ >= integer.capacity_)
-	{
-		larger = this;
-		smaller = &integer;
-	}
-	else
+	return _BIGNUM_DETAILS::compare(numerator_ * value.denominator_, value.numerator_ * denominator_);
+}
+// Reduces an unnormalized value once it grows past _BIGNUM_RATIONAL_THRESHOLD blocks.
+void bigrational::grow_()
+{
+	const size_type size = _BIGNUM_DETAILS::used_size(numerator_.data(), numerator_.capacity()) + _BIGNUM_DETAILS::used_size(denominator_.data(), denominator_.capacity());
+
+	if (numerator_.zero() || size > _BIGNUM_RATIONAL_THRESHOLD)
 	{
-		larger = &integer;
-		smaller = this;
+		normalize();
 	}
+}
 
-	const size_type limit = smaller->capacity_;
+const bigint& bigrational::numerator() const noexcept
+{
+	return numerator_;
+}
+const bigint& bigrational::denominator() const noexcept
+{
+	return denominator_;
+}
 
-	bool result = false;
+// Picks the largest primes below 2^31, each above 2^30, until their product exceeds 2^(bits + 1),
+// so every integer of at most bits bits has a distinct residue vector.
+bigint_rns_basis::bigint_rns_basis(size_type bits, unsigned threads)
+	: bits_(bits), threads_(threads)
+{
+	const size_type size = (bits + 1) / 30 + 1;
 
-	for (size_type i = larger->capacity_ - 1; i >= limit; --i)
+	for (residue_type candidate = 0x7FFFFFFF; primes_.size() < size; candidate -= 2)
 	{
-		if (larger->data_[i])
+		if (_BIGNUM_DETAILS::word_prime(candidate))
 		{
-			result = smaller == this;
-			goto exit;
+			primes_.push_back(candidate);
 		}
 	}
 
-	for (size_type i = limit - 1; i >= 0; --i)
+	inverses_.resize(size);
+	squares_.resize(size);
+
+	for (size_type i = 0; i < size; ++i)
 	{
-		if (data_[i] < integer.data_[i])
-		{
-			result = true;
-			goto exit;
-		}
-		else if (data_[i] > integer.data_[i])
-		{
-			result = false;
-			goto exit;
-		}
-		else if (i == 0)
+		residue_type inverse = primes_[i];
+
+		for (int j = 0; j < 4; ++j)
 		{
-			return true;
+			inverse *= 2 - primes_[i] * inverse;
 		}
-	}
 
-exit:
-	return sign_ ? !result : result;
-}
-bigint bigint::operator+(const bigint& integer) const
-{
-	return bigint(*this) += integer;
-}
-bigint& bigint::operator+=(const bigint& integer)
-{
-	if (sign_ == integer.sign_)
-	{
-		add_unsigned_(integer);
-	}
-	else
-	{
-		sub_unsigned_(integer);
+		inverses_[i] = 0 - inverse;
+		squares_[i] = static_cast<residue_type>((static_cast<std::uint64_t>(1) << 62) % primes_[i] * 4 % primes_[i]);
 	}
 
-	return *this;
-}
-bigint& bigint::operator++()
-{
-	if (capacity_)
+	std::vector<bigint> primes(primes_.begin(), primes_.end());
+
+	tree_ = bigint_product_tree(primes, threads);
+	half_ = tree_.product() >> 1;
+
+	if (size < _BIGNUM_DETAILS::rns_tree_threshold)
 	{
-		for (size_type i = 0; i < capacity_; ++i)
-		{
-			data_[i] += 1 - (sign_ << 1);
-			if (data_[i]) goto check_zero;
-		}
+		// Garner's constants: the inverse of p[0] * ... * p[i - 1] modulo p[i].
+		garner_.resize(size);
 
+		for (size_type i = 0; i < size; ++i)
 		{
-			block_type* const old_data = data_;
-
-			capacity_ += 1;
-			data_ = reinterpret_cast<block_type*>(std::realloc(data_, capacity_ * sizeof(block_type)));
+			std::uint64_t product = 1;
 
-			if (!data_)
+			for (size_type j = 0; j < i; ++j)
 			{
-				capacity_ -= 1;
-				data_ = old_data;
-				throw std::bad_alloc();
+				product = product * (primes_[j] % primes_[i]) % primes_[i];
 			}
 
-			data_[capacity_ - 1] = 1;
-
-			return *this;
-		}
-
-	check_zero:
-		if (sign_ && zero())
-		{
-			sign_ = false;
+			garner_[i] = _BIGNUM_DETAILS::power_mod(product, primes_[i] - 2, primes_[i]);
 		}
 	}
 	else
 	{
-		capacity_ = 1;
-		data_ = reinterpret_cast<block_type*>(std::calloc(1, sizeof(block_type)));
-
-		if (!data_)
+		// The inverse of M / p[i] modulo p[i], with (M / p[i]) mod p[i] read off M mod p[i]^2.
+		for (bigint& prime : primes)
 		{
-			capacity_ = 0;
-			throw std::bad_alloc();
+			prime *= prime;
 		}
 
-		*data_ = 1;
+		const std::vector<bigint> remainders = bigint_product_tree(primes, threads).remainders(tree_.product(), threads);
+
+		weights_.resize(size);
+
+		_BIGNUM_DETAILS::parallel_for(size, _BIGNUM_DETAILS::thread_count(threads, size), [&](std::size_t index, unsigned)
+		{
+			const bigint cofactor = remainders[index] / bigint(primes_[index]);
+
+			weights_[index] = _BIGNUM_DETAILS::power_mod(cofactor.zero() ? 0 : cofactor.data()[0], primes_[index] - 2, primes_[index]);
+		});
 	}
+}
 
-	return *this;
+bigint_rns_basis::size_type bigint_rns_basis::size() const noexcept
+{
+	return primes_.size();
 }
-bigint bigint::operator++(int)
+bigint_rns_basis::size_type bigint_rns_basis::bits() const noexcept
 {
-	bigint ret = *this;
-	return ++(*this), ret;
+	return bits_;
 }
-bigint bigint::operator-(const bigint& integer) const
+unsigned bigint_rns_basis::threads() const noexcept
 {
-	return bigint(*this) -= integer;
+	return threads_;
 }
-bigint& bigint::operator-=(const bigint& integer)
+const bigint_rns_basis::residue_type* bigint_rns_basis::primes() const noexcept
+{
+	return primes_.data();
+}
+const bigint& bigint_rns_basis::modulus() const noexcept
 {
-	if (sign_ == integer.sign_)
+	return tree_.product();
+}
+
+bigint_rns::bigint_rns(const bigint_rns_basis& basis)
+	: basis_(&basis), residues_(basis.size(), 0)
+{}
+// Residues are kept in Montgomery form, so products need no division.
+bigint_rns::bigint_rns(const bigint_rns_basis& basis, const bigint_view& integer)
+	: basis_(&basis), residues_(basis.size())
+{
+	const bigint_view magnitude(integer.data(), integer.capacity());
+	const size_type blocks = _BIGNUM_DETAILS::used_size(integer.data(), integer.capacity());
+	const bool sign = integer.sign();
+
+	if (basis.size() < _BIGNUM_DETAILS::rns_tree_threshold)
 	{
-		sub_unsigned_(integer);
+		for (size_type i = 0; i < residues_.size(); ++i)
+		{
+			residues_[i] = _BIGNUM_DETAILS::mod_1(integer.data(), blocks, basis.primes_[i]);
+		}
 	}
 	else
 	{
-		add_unsigned_(integer);
+		const std::vector<bigint> remainders = basis.tree_.remainders(magnitude, basis.threads_);
+
+		for (size_type i = 0; i < residues_.size(); ++i)
+		{
+			residues_[i] = remainders[i].zero() ? 0 : remainders[i].data()[0];
+		}
 	}
 
-	return *this;
+	_BIGNUM_DETAILS::parallel_chunks(residues_.size(), basis.threads_, [&](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const residue_type prime = basis.primes_[i];
+			const residue_type residue = sign && residues_[i] ? prime - residues_[i] : residues_[i];
+
+			residues_[i] = _BIGNUM_DETAILS::redc_word(static_cast<std::uint64_t>(residue) * basis.squares_[i], prime, basis.inverses_[i]);
+		}
+	});
 }
-bool bigint::operator!() const noexcept
+
+bool bigint_rns::operator==(const bigint_rns& value) const
 {
-	return zero();
+	check_(value);
+
+	return residues_ == value.residues_;
 }
-bigint::operator bool() const noexcept
+bool bigint_rns::operator!=(const bigint_rns& value) const
 {
-	return !zero();
+	return !(*this == value);
 }
-
-void bigint::reset() noexcept
+bigint_rns bigint_rns::operator+(const bigint_rns& value) const
 {
-	std::free(data_);
+	bigint_rns result(*this);
 
-	data_ = nullptr;
-	capacity_ = 0;
-	sign_ = false;
-}
-void bigint::swap(bigint& integer) noexcept
-{
-	if (this == &integer) return;
+	result += value;
 
-	std::swap(data_, integer.data_);
-	std::swap(capacity_, integer.capacity_);
-	std::swap(sign_, integer.sign_);
+	return result;
 }
-
-void bigint::reserve(size_type new_capacity)
+bigint_rns& bigint_rns::operator+=(const bigint_rns& value)
 {
-	if (new_capacity > capacity_)
-	{
-		block_type* const old_data = data_;
-		const size_type old_capacity = capacity_;
+	check_(value);
 
-		data_ = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * new_capacity));
-		capacity_ = new_capacity;
+	const residue_type* const primes = basis_->primes_.data();
+	const residue_type* const source = value.residues_.data();
+	residue_type* const target = residues_.data();
 
-		if (!data_)
+	_BIGNUM_DETAILS::parallel_chunks(residues_.size(), basis_->threads_, [=](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
 		{
-			data_ = old_data;
-			capacity_ = old_capacity;
-			throw std::bad_alloc();
+			const residue_type sum = target[i] + source[i];
+
+			target[i] = sum >= primes[i] ? sum - primes[i] : sum;
 		}
+	});
 
-		std::fill(data_ + old_capacity, data_ + capacity_, 0);
-	}
+	return *this;
 }
-void bigint::shrink_to_fit()
+bigint_rns bigint_rns::operator-(const bigint_rns& value) const
 {
-	if (data_)
-	{
-		block_type* const old_data = data_;
-		const size_type old_capacity = capacity_;
-
-		for (size_type i = capacity_ - 1; i >= 0; --i)
-		{
-			if (data_[i] != 0 && i + 1 != capacity_)
-			{
-				if (!(data_ = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * (capacity_ = i + 1)))))
-				{
-					data_ = old_data;
-					capacity_ = old_capacity;
-					throw std::bad_alloc();
-				}
-
-				return;
-			}
+	bigint_rns result(*this);
 
-			if (i == 0)
-			{
-				std::free(data_);
-				data_ = nullptr;
-				capacity_ = 0;
-				sign_ = false;
+	result -= value;
 
-				return;
-			}
-		}
-	}
+	return result;
 }
-
-bool bigint::zero() const noexcept
+bigint_rns& bigint_rns::operator-=(const bigint_rns& value)
 {
-	if (capacity_ == 0) return true;
+	check_(value);
 
-	for (size_type i = 0; i < capacity_; ++i)
+	const residue_type* const primes = basis_->primes_.data();
+	const residue_type* const source = value.residues_.data();
+	residue_type* const target = residues_.data();
+
+	_BIGNUM_DETAILS::parallel_chunks(residues_.size(), basis_->threads_, [=](std::size_t begin, std::size_t end)
 	{
-		if (data_[i]) return false;
-	}
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const residue_type difference = target[i] - source[i];
 
-	return true;
+			target[i] = target[i] < source[i] ? difference + primes[i] : difference;
+		}
+	});
+
+	return *this;
 }
-bool bigint::positive() const noexcept
+bigint_rns bigint_rns::operator*(const bigint_rns& value) const
 {
-	return !sign_ && !zero();
+	bigint_rns result(*this);
+
+	result *= value;
+
+	return result;
 }
-bool bigint::negative() const noexcept
+bigint_rns& bigint_rns::operator*=(const bigint_rns& value)
 {
-	return sign_;
-}
+	check_(value);
 
-void bigint::add_unsigned_(const bigint& integer)
-{
-	if (!capacity_)
+	const residue_type* const primes = basis_->primes_.data();
+	const residue_type* const inverses = basis_->inverses_.data();
+	const residue_type* const source = value.residues_.data();
+	residue_type* const target = residues_.data();
+
+	_BIGNUM_DETAILS::parallel_chunks(residues_.size(), basis_->threads_, [=](std::size_t begin, std::size_t end)
 	{
-		if (!integer.capacity_) return;
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			target[i] = _BIGNUM_DETAILS::redc_word(static_cast<std::uint64_t>(target[i]) * source[i], primes[i], inverses[i]);
+		}
+	});
 
-		capacity_ = integer.capacity_;
-		data_ = reinterpret_cast<block_type*>(std::malloc(sizeof(block_type) * capacity_));
+	return *this;
+}
+bigint_rns bigint_rns::operator-() const
+{
+	bigint_rns result(*this);
 
-		if (!data_)
+	for (size_type i = 0; i < result.residues_.size(); ++i)
+	{
+		if (result.residues_[i])
 		{
-			capacity_ = 0;
-			throw std::bad_alloc();
+			result.residues_[i] = basis_->primes_[i] - result.residues_[i];
 		}
+	}
 
-		sign_ = integer.sign_;
+	return result;
+}
 
-		std::copy(integer.data_, integer.data_ + integer.capacity_, data_);
-		return;
-	}
-	else if (!integer.capacity_) return;
+void bigint_rns::swap(bigint_rns& value) noexcept
+{
+	std::swap(basis_, value.basis_);
+	residues_.swap(value.residues_);
+}
 
-	const size_type limit = std::min(capacity_, integer.capacity_);
+bool bigint_rns::zero() const noexcept
+{
+	return std::all_of(residues_.begin(), residues_.end(), [](residue_type residue) { return residue == 0; });
+}
+// Reconstructs the value in the symmetric range (-M / 2, M / 2], through Garner's mixed radix form for
+// small bases and through the product tree for large ones.
+bigint bigint_rns::to_bigint() const
+{
+	if (!basis_) return bigint();
 
-	bool carry = false;
+	const bigint_rns_basis& basis = *basis_;
+	const size_type size = residues_.size();
+	std::vector<residue_type> values(size);
 
-	for (size_type i = 0; i < limit; ++i)
+	for (size_type i = 0; i < size; ++i)
 	{
-		data_[i] += integer.data_[i] + carry;
-		carry = (data_[i] < integer.data_[i]) || !(data_[i] + 1);
+		values[i] = _BIGNUM_DETAILS::redc_word(residues_[i], basis.primes_[i], basis.inverses_[i]);
 	}
 
-	block_type* const old_data = data_;
-	const size_type old_capacity = capacity_;
+	bigint result;
 
-	if (capacity_ < integer.capacity_)
+	if (size < _BIGNUM_DETAILS::rns_tree_threshold)
 	{
-		capacity_ = (carry && integer.data_[integer.capacity_ - 1] == std::numeric_limits<block_type>::max()) ? (integer.capacity_ + 1) : integer.capacity_;
-		data_ = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * capacity_));
-
-		if (!data_)
+		for (size_type i = 1; i < size; ++i)
 		{
-			data_ = old_data;
-			capacity_ = old_capacity;
-			throw std::bad_alloc();
-		}
+			const std::uint64_t prime = basis.primes_[i];
+			std::uint64_t sum = values[i - 1] % prime;
 
-		data_[capacity_ - 1] = 0;
-		std::copy(data_ + limit, data_ + capacity_, integer.data_ + limit);
-	}
-	else if (carry && data_[capacity_ - 1] == std::numeric_limits<block_type>::max())
-	{
-		capacity_ += 1;
-		data_ = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * capacity_));
+			for (size_type j = i - 1; j-- > 0;)
+			{
+				sum = (sum * (basis.primes_[j] % prime) + values[j]) % prime;
+			}
 
-		if (!data_)
-		{
-			data_ = old_data;
-			capacity_ = old_capacity;
-			throw std::bad_alloc();
+			values[i] = static_cast<residue_type>((values[i] + prime - sum) % prime * basis.garner_[i] % prime);
 		}
 
-		data_[capacity_ - 1] = 0;
-	}
+		result = bigint(values[size - 1]);
 
-	if (carry)
-	{
-		for (size_type i = limit; i < capacity_; ++i)
+		for (size_type i = size - 1; i-- > 0;)
 		{
-			data_[i] += 1;
-			if (data_[i]) break;
+			result *= bigint(basis.primes_[i]);
+			result += bigint(values[i]);
 		}
 	}
-}
-void bigint::sub_unsigned_(const bigint& integer)
-{
-	if (!capacity_)
+	else
 	{
-		if (!integer.capacity_) return;
-
-		capacity_ = integer.capacity_;
-		data_ = reinterpret_cast<block_type*>(std::malloc(sizeof(block_type) * capacity_));
+		std::vector<bigint> sums(size);
 
-		if (!data_)
+		for (size_type i = 0; i < size; ++i)
 		{
-			capacity_ = 0;
-			throw std::bad_alloc();
+			sums[i] = bigint(static_cast<residue_type>(static_cast<std::uint64_t>(values[i]) * basis.weights_[i] % basis.primes_[i]));
 		}
 
-		sign_ = !integer.sign_;
-		std::copy(integer.data_, integer.data_ + integer.capacity_, data_);
-
-		if (zero())
+		// Each node combines its children as left * product(right) + right * product(left).
+		for (size_type level = 0; level + 1 < basis.tree_.levels(); ++level)
 		{
-			sign_ = false;
-		}
-
-		return;
-	}
-	else if (!integer.capacity_) return;
+			const std::vector<bigint>& products = basis.tree_.level(level);
+			std::vector<bigint> parents((sums.size() + 1) / 2);
 
-	const size_type limit = std::min(capacity_, integer.capacity_);
+			_BIGNUM_DETAILS::parallel_for(parents.size(), _BIGNUM_DETAILS::thread_count(basis.threads_, parents.size()), [&](std::size_t index, unsigned)
+			{
+				if (index * 2 + 1 < sums.size())
+				{
+					parents[index] = sums[index * 2] * products[index * 2 + 1] + sums[index * 2 + 1] * products[index * 2];
+				}
+				else
+				{
+					parents[index] = std::move(sums[index * 2]);
+				}
+			});
 
-	bool borrow = false;
-	std::int64_t preserved;
+			sums.swap(parents);
+		}
 
-	for (size_type i = 0; i < limit; ++i)
-	{
-		preserved = static_cast<std::int64_t>(data_[i]) - integer.data_[i] - borrow;
-		borrow = preserved < 0 ? ((preserved = -preserved), true) : false;
-		data_[i] = static_cast<block_type>(preserved);
+		result = sums[0] % basis.modulus();
 	}
 
-	if (capacity_ < integer.capacity_)
+	if (result > basis.half_)
 	{
-		block_type* const old_data = data_;
-		const size_type old_capacity = capacity_;
-
-		capacity_ = integer.capacity_;
-		data_ = reinterpret_cast<block_type*>(std::realloc(data_, sizeof(block_type) * capacity_));
-
-		if (!data_)
-		{
-			data_ = old_data;
-			capacity_ = old_capacity;
-			throw std::bad_alloc();
-		}
-				
-		for (size_type i = limit; i < capacity_; ++i)
-		{
-			preserved = static_cast<std::int64_t>(integer.data_[i]) + borrow;
-			borrow = preserved < 0 ? ((preserved = -preserved), true) : false;
-			data_[i] = static_cast<block_type>(preserved);
-		}
-
-		if (borrow)
-		{
-			sign_ = !sign_;
-		}
+		result -= basis.modulus();
 	}
-	else if (borrow && capacity_ >= 2)
-	{
-		for (size_type i = 0; i < capacity_ - 1; ++i)
-		{
-			data_[i] = std::numeric_limits<block_type>::max() - data_[i] + 1;
-		}
-		data_[capacity_ - 1] -= 1;
 
-		sign_ = !sign_;
-	}
+	return result;
 }
 
-const bigint::block_type* bigint::data() const noexcept
+void bigint_rns::check_(const bigint_rns& value) const
 {
-	return data_;
+	if (!basis_ || basis_ != value.basis_) throw std::invalid_argument("basis() != value.basis()");
 }
-bigint::block_type* bigint::data() noexcept
+
+const bigint_rns_basis* bigint_rns::basis() const noexcept
 {
-	return data_;
+	return basis_;
 }
-bigint::size_type bigint::capacity() const noexcept
+const bigint_rns::residue_type* bigint_rns::data() const noexcept
 {
-	return capacity_;
+	return residues_.data();
 }
-bool bigint::sign() const noexcept
+bigint_rns::size_type bigint_rns::size() const noexcept
 {
-	return sign_;
+	return residues_.size();
 }
 
 #ifdef _BIGNUM_HAS_NAMESPACE
@@ -43,8 +43,12 @@
 ///// Includes
 /////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
 
 /////////////////////////////////////////////////////////////////
 ///// Declarations
@@ -55,12 +59,96 @@ namespace _BIGNUM_HAS_NAMESPACE
 {
 #endif
 
+class bigint_view;
+
+struct bigint_stats
+{
+	using counter_type = std::uint64_t;
+
+	enum class site
+	{
+		construct,
+		copy,
+		assign,
+		reserve,
+		shrink,
+		add,
+		sub,
+		increment,
+		multiply,
+		divide,
+		shift,
+		from_bytes,
+		accumulator,
+		array,
+	};
+	enum class operation
+	{
+		construct,
+		copy,
+		assign,
+		compare,
+		add,
+		sub,
+		increment,
+		multiply,
+		divide,
+		shift,
+		to_string,
+		from_bytes,
+		to_bytes,
+		accumulate,
+	};
+
+#ifdef _BIGNUM_STATS
+	static constexpr bool enabled = true;
+#else
+	static constexpr bool enabled = false;
+#endif
+	static constexpr std::size_t sites = static_cast<std::size_t>(site::array) + 1;
+	static constexpr std::size_t operations = static_cast<std::size_t>(operation::accumulate) + 1;
+	static constexpr std::size_t buckets = 65;
+
+	counter_type allocations[sites] = {};
+	counter_type reallocations[sites] = {};
+	counter_type bytes[sites] = {};
+	counter_type calls[operations] = {};
+	counter_type sizes[operations][buckets] = {};
+
+	static bigint_stats snapshot();
+	static void reset();
+
+	static const char* name(site site) noexcept;
+	static const char* name(operation operation) noexcept;
+};
+
+struct bigint_thresholds
+{
+	using size_type = std::size_t;
+
+	size_type karatsuba;
+	size_type toom3;
+
+	static bigint_thresholds defaults() noexcept;
+	static bigint_thresholds get() noexcept;
+	static void set(const bigint_thresholds& thresholds);
+
+	static bigint_thresholds load(const char* path);
+	void save(const char* path) const;
+};
+
 class bigint
 {
 public:
 	using block_type = std::uint32_t;
 	using size_type = std::size_t;
 
+	enum class byte_order
+	{
+		little,
+		big,
+	};
+
 public:
 	bigint() noexcept = default;
 	bigint(std::int32_t integer);
@@ -70,23 +158,50 @@ public:
 	bigint(const bigint& integer);
 	bigint(const bigint& integer, size_type new_capacity);
 	bigint(bigint&& integer) noexcept;
+	explicit bigint(const bigint_view& integer);
 	~bigint();
 
 public:
 	bigint& operator=(const bigint& integer);
 	bigint& operator=(bigint&& integer) noexcept;
 	bool operator==(const bigint& integer) const noexcept;
+	bool operator==(const bigint_view& integer) const noexcept;
 	bool operator!=(const bigint& integer) const noexcept;
+	bool operator!=(const bigint_view& integer) const noexcept;
 	bool operator>(const bigint& integer) const noexcept;
+	bool operator>(const bigint_view& integer) const noexcept;
 	bool operator>=(const bigint& integer) const noexcept;
+	bool operator>=(const bigint_view& integer) const noexcept;
 	bool operator<(const bigint& integer) const noexcept;
+	bool operator<(const bigint_view& integer) const noexcept;
 	bool operator<=(const bigint& integer) const noexcept;
+	bool operator<=(const bigint_view& integer) const noexcept;
 	bigint operator+(const bigint& integer) const;
+	bigint operator+(const bigint_view& integer) const;
 	bigint& operator+=(const bigint& integer);
+	bigint& operator+=(const bigint_view& integer);
 	bigint& operator++();
 	bigint operator++(int);
 	bigint operator-(const bigint& integer) const;
+	bigint operator-(const bigint_view& integer) const;
 	bigint& operator-=(const bigint& integer);
+	bigint& operator-=(const bigint_view& integer);
+	bigint operator*(const bigint& integer) const;
+	bigint operator*(const bigint_view& integer) const;
+	bigint& operator*=(const bigint& integer);
+	bigint& operator*=(const bigint_view& integer);
+	bigint operator/(const bigint& integer) const;
+	bigint operator/(const bigint_view& integer) const;
+	bigint& operator/=(const bigint& integer);
+	bigint& operator/=(const bigint_view& integer);
+	bigint operator%(const bigint& integer) const;
+	bigint operator%(const bigint_view& integer) const;
+	bigint& operator%=(const bigint& integer);
+	bigint& operator%=(const bigint_view& integer);
+	bigint operator<<(size_type shift) const;
+	bigint& operator<<=(size_type shift);
+	bigint operator>>(size_type shift) const;
+	bigint& operator>>=(size_type shift);
 	bool operator!() const noexcept;
 	explicit operator bool() const noexcept;
 
@@ -101,9 +216,301 @@ public:
 	bool positive() const noexcept;
 	bool negative() const noexcept;
 
+	static bigint from_bytes(const void* bytes, size_type size, byte_order order = byte_order::little, bool sign = false);
+	size_type byte_size() const noexcept;
+	void to_bytes(void* bytes, size_type size, byte_order order = byte_order::little) const;
+	std::string to_string() const;
+
+	static void divmod(const bigint_view& dividend, const bigint_view& divisor, bigint& quotient, bigint& remainder);
+	static bigint gcd(const bigint_view& a, const bigint_view& b);
+
+	bool is_probable_prime(unsigned rounds = 0) const;
+	static bigint next_prime(const bigint_view& integer, unsigned rounds = 0, unsigned threads = 1);
+	static std::vector<bigint> filter_primes(const std::vector<bigint>& integers, unsigned rounds = 0, unsigned threads = 1);
+
+	static const char* kernel_name() noexcept;
+
+private:
+	void reserve_(size_type new_capacity, bigint_stats::site site);
+	void add_unsigned_(const bigint_view& integer);
+	void sub_unsigned_(const bigint_view& integer);
+
+public:
+	const block_type* data() const noexcept;
+	block_type* data() noexcept;
+	size_type capacity() const noexcept;
+	bool sign() const noexcept;
+
+private:
+	block_type* data_ = nullptr;
+	size_type capacity_ = 0;
+	bool sign_ = false;
+
+	friend class bigint_accumulator;
+	friend class bigrational;
+};
+
+class bigint_view
+{
+public:
+	using block_type = bigint::block_type;
+	using size_type = bigint::size_type;
+	using byte_order = bigint::byte_order;
+
+public:
+	constexpr bigint_view() noexcept = default;
+	constexpr bigint_view(const block_type* data, size_type capacity, bool sign = false) noexcept
+		: data_(data), capacity_(capacity), sign_(sign)
+	{}
+	bigint_view(const bigint& integer) noexcept;
+
+public:
+	bool operator==(const bigint_view& integer) const noexcept;
+	bool operator!=(const bigint_view& integer) const noexcept;
+	bool operator>(const bigint_view& integer) const noexcept;
+	bool operator>=(const bigint_view& integer) const noexcept;
+	bool operator<(const bigint_view& integer) const noexcept;
+	bool operator<=(const bigint_view& integer) const noexcept;
+	bigint operator+(const bigint_view& integer) const;
+	bigint operator-(const bigint_view& integer) const;
+	bigint operator*(const bigint_view& integer) const;
+	bigint operator/(const bigint_view& integer) const;
+	bigint operator%(const bigint_view& integer) const;
+	bigint operator<<(size_type shift) const;
+	bigint operator>>(size_type shift) const;
+	constexpr bigint_view operator-() const noexcept
+	{
+		return bigint_view(data_, capacity_, !sign_);
+	}
+	bool operator!() const noexcept;
+	explicit operator bool() const noexcept;
+
+public:
+	bool zero() const noexcept;
+	bool positive() const noexcept;
+	bool negative() const noexcept;
+
+	size_type byte_size() const noexcept;
+	void to_bytes(void* bytes, size_type size, byte_order order = byte_order::little) const;
+	std::string to_string() const;
+
+	bool is_probable_prime(unsigned rounds = 0) const;
+
+public:
+	constexpr const block_type* data() const noexcept
+	{
+		return data_;
+	}
+	constexpr size_type capacity() const noexcept
+	{
+		return capacity_;
+	}
+	constexpr bool sign() const noexcept
+	{
+		return sign_;
+	}
+
+private:
+	const block_type* data_ = nullptr;
+	size_type capacity_ = 0;
+	bool sign_ = false;
+};
+
+_BIGNUM_DETAILS_BEGIN
+template<std::size_t Size>
+struct literal_blocks
+{
+	bigint::block_type data[Size];
+};
+
+template<char... Digits>
+constexpr bool literal_valid() noexcept
+{
+	const char digits[] = { Digits... };
+
+	for (char digit : digits)
+	{
+		if (digit == '.' || ((digit == 'e' || digit == 'E' || digit == 'p' || digit == 'P') && !(digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X'))))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+// Parses an integer literal with an optional 0x, 0b or 0 prefix into Size blocks, least significant first.
+template<std::size_t Size, char... Digits>
+constexpr literal_blocks<Size> literal_parse() noexcept
+{
+	const char digits[] = { Digits... };
+	const std::size_t count = sizeof...(Digits);
+	literal_blocks<Size> result{};
+	std::uint32_t base = 10;
+	std::size_t begin = 0;
+
+	if (count > 1 && digits[0] == '0')
+	{
+		if (digits[1] == 'x' || digits[1] == 'X') base = 16, begin = 2;
+		else if (digits[1] == 'b' || digits[1] == 'B') base = 2, begin = 2;
+		else base = 8, begin = 1;
+	}
+
+	for (std::size_t i = begin; i < count; ++i)
+	{
+		const char digit = digits[i];
+		std::uint64_t carry = 0;
+
+		if (digit >= 'a') carry = static_cast<std::uint64_t>(digit - 'a' + 10);
+		else if (digit >= 'A') carry = static_cast<std::uint64_t>(digit - 'A' + 10);
+		else carry = static_cast<std::uint64_t>(digit - '0');
+
+		// Digit separators are skipped.
+		for (std::size_t j = 0; j < Size && digit != '\''; ++j)
+		{
+			carry += static_cast<std::uint64_t>(result.data[j]) * base;
+			result.data[j] = static_cast<bigint::block_type>(carry);
+			carry >>= 32;
+		}
+	}
+
+	return result;
+}
+// Every digit adds at most 4 bits, so the first parse is sized from the digit count and only used to find the exact size.
+template<char... Digits>
+constexpr std::size_t literal_size() noexcept
+{
+	const literal_blocks<sizeof...(Digits) / 8 + 1> blocks = literal_parse<sizeof...(Digits) / 8 + 1, Digits...>();
+	std::size_t size = sizeof...(Digits) / 8 + 1;
+
+	while (size && !blocks.data[size - 1])
+	{
+		--size;
+	}
+
+	return size;
+}
+
+template<char... Digits>
+struct literal
+{
+	static constexpr std::size_t size = literal_size<Digits...>();
+	static constexpr literal_blocks<size ? size : 1> value = literal_parse<size ? size : 1, Digits...>();
+};
+
+template<char... Digits>
+constexpr literal_blocks<literal<Digits...>::size ? literal<Digits...>::size : 1> literal<Digits...>::value;
+_BIGNUM_DETAILS_END
+
+inline namespace literals
+{
+	// The blocks live in static storage, so the view needs no allocation and can be used for the whole program.
+	template<char... Digits>
+	constexpr bigint_view operator"" _big() noexcept
+	{
+		static_assert(_BIGNUM_DETAILS::literal_valid<Digits...>(), "_big needs an integer literal");
+
+		return bigint_view(_BIGNUM_DETAILS::literal<Digits...>::value.data, _BIGNUM_DETAILS::literal<Digits...>::size);
+	}
+}
+
+class bigint_array
+{
+public:
+	using block_type = bigint::block_type;
+	using size_type = bigint::size_type;
+
+public:
+	bigint_array() noexcept = default;
+	bigint_array(const bigint_array& array);
+	bigint_array(bigint_array&& array) noexcept;
+	~bigint_array();
+
+public:
+	bigint_array& operator=(const bigint_array& array);
+	bigint_array& operator=(bigint_array&& array) noexcept;
+	bigint_view operator[](size_type index) const noexcept;
+
+public:
+	void reset() noexcept;
+	void swap(bigint_array& array) noexcept;
+
+	void reserve(size_type new_capacity, size_type new_block_capacity);
+	void push_back(const bigint_view& integer);
+	bigint_view at(size_type index) const;
+
+	bool empty() const noexcept;
+	size_type size() const noexcept;
+	size_type blocks() const noexcept;
+	bool mapped() const noexcept;
+
+	void save(const char* path) const;
+	static bigint_array load(const char* path);
+
+private:
+	void detach_(size_type new_capacity, size_type new_block_capacity);
+
+public:
+	const std::uint64_t* index() const noexcept;
+	const block_type* data() const noexcept;
+	size_type capacity() const noexcept;
+	size_type block_capacity() const noexcept;
+
+private:
+	std::uint64_t* index_ = nullptr;
+	block_type* data_ = nullptr;
+	size_type size_ = 0;
+	size_type capacity_ = 0;
+	size_type blocks_ = 0;
+	size_type block_capacity_ = 0;
+	void* mapping_ = nullptr;
+	size_type mapping_size_ = 0;
+};
+
+class bigint_file
+{
+public:
+	using block_type = bigint::block_type;
+	using size_type = bigint::size_type;
+
+public:
+	explicit bigint_file(const char* directory = nullptr);
+	explicit bigint_file(const bigint_view& integer, const char* directory = nullptr);
+	bigint_file(const bigint_file&) = delete;
+	bigint_file(bigint_file&& integer) noexcept;
+	~bigint_file();
+
+public:
+	bigint_file& operator=(const bigint_file&) = delete;
+	bigint_file& operator=(bigint_file&& integer) noexcept;
+	bigint_file& operator=(const bigint_view& integer);
+	bool operator==(const bigint_view& integer) const noexcept;
+	bool operator!=(const bigint_view& integer) const noexcept;
+	bool operator>(const bigint_view& integer) const noexcept;
+	bool operator>=(const bigint_view& integer) const noexcept;
+	bool operator<(const bigint_view& integer) const noexcept;
+	bool operator<=(const bigint_view& integer) const noexcept;
+	bigint_file& operator+=(const bigint_view& integer);
+	bigint_file& operator-=(const bigint_view& integer);
+	bigint_file& operator*=(const bigint_view& integer);
+	operator bigint_view() const noexcept;
+
+public:
+	void reset() noexcept;
+	void swap(bigint_file& integer) noexcept;
+
+	void reserve(size_type new_capacity);
+
+	bool zero() const noexcept;
+	bool positive() const noexcept;
+	bool negative() const noexcept;
+
+	static void multiply(bigint_file& result, const bigint_view& a, const bigint_view& b);
+
 private:
-	void add_unsigned_(const bigint& integer);
-	void sub_unsigned_(const bigint& integer);
+	int compare_(const bigint_view& integer) const noexcept;
+	int compare_unsigned_(const bigint_view& integer) const noexcept;
+	void add_unsigned_(const bigint_view& integer);
+	void sub_unsigned_(const bigint_view& integer);
 
 public:
 	const block_type* data() const noexcept;
@@ -115,6 +522,365 @@ private:
 	block_type* data_ = nullptr;
 	size_type capacity_ = 0;
 	bool sign_ = false;
+	std::intptr_t file_ = -1;
+	std::string directory_;
+};
+
+class bigint_accumulator
+{
+public:
+	using block_type = std::int64_t;
+	using size_type = std::size_t;
+
+public:
+	bigint_accumulator() noexcept = default;
+	bigint_accumulator(const bigint_accumulator& accumulator);
+	bigint_accumulator(bigint_accumulator&& accumulator) noexcept;
+	~bigint_accumulator();
+
+public:
+	bigint_accumulator& operator=(const bigint_accumulator& accumulator);
+	bigint_accumulator& operator=(bigint_accumulator&& accumulator) noexcept;
+	bigint_accumulator& operator+=(const bigint_view& integer);
+	bigint_accumulator& operator-=(const bigint_view& integer);
+
+public:
+	void reset() noexcept;
+	void swap(bigint_accumulator& accumulator) noexcept;
+
+	void reserve(size_type new_capacity);
+	void normalize();
+
+	bigint value() const;
+
+private:
+	void add_blocks_(const bigint::block_type* data, size_type size, bool negative);
+
+public:
+	const block_type* data() const noexcept;
+	size_type capacity() const noexcept;
+	size_type pending() const noexcept;
+
+private:
+	block_type* data_ = nullptr;
+	size_type capacity_ = 0;
+	size_type pending_ = 0;
+
+	friend class bigint_concurrent_accumulator;
+};
+
+class bigint_concurrent_accumulator
+{
+public:
+	using size_type = std::size_t;
+
+public:
+	bigint_concurrent_accumulator();
+	bigint_concurrent_accumulator(const bigint_concurrent_accumulator&) = delete;
+	~bigint_concurrent_accumulator();
+
+public:
+	bigint_concurrent_accumulator& operator=(const bigint_concurrent_accumulator&) = delete;
+	bigint_concurrent_accumulator& operator+=(const bigint_view& integer);
+	bigint_concurrent_accumulator& operator-=(const bigint_view& integer);
+
+public:
+	bigint value() const;
+	size_type shards() const noexcept;
+	size_type capacity() const noexcept;
+
+private:
+	struct buffer_;
+	struct shard_;
+
+	shard_* local_shard_();
+	void add_blocks_(const bigint::block_type* data, size_type size, bool negative);
+	buffer_* grow_(shard_* shard, size_type new_capacity, bool split);
+
+private:
+	const std::uint64_t id_;
+	std::atomic<shard_*> shards_;
+	mutable std::atomic<size_type> readers_;
+	std::mutex mutex_;
+};
+
+class bigint_handle
+{
+public:
+	using size_type = std::size_t;
+
+public:
+	bigint_handle() noexcept = default;
+	bigint_handle(const bigint& integer);
+	bigint_handle(bigint&& integer);
+	bigint_handle(const bigint_handle& handle) noexcept;
+	bigint_handle(bigint_handle&& handle) noexcept;
+	~bigint_handle();
+
+public:
+	bigint_handle& operator=(const bigint_handle& handle) noexcept;
+	bigint_handle& operator=(bigint_handle&& handle) noexcept;
+	const bigint& operator*() const noexcept;
+	const bigint* operator->() const noexcept;
+	operator const bigint&() const noexcept;
+
+public:
+	void reset() noexcept;
+	void swap(bigint_handle& handle) noexcept;
+
+	const bigint& get() const noexcept;
+	bigint& mutate();
+
+	bool unique() const noexcept;
+	size_type use_count() const noexcept;
+
+private:
+	struct shared_;
+
+	void release_() noexcept;
+
+private:
+	shared_* block_ = nullptr;
+};
+
+class bigint_product_tree
+{
+public:
+	using size_type = std::size_t;
+
+public:
+	bigint_product_tree() noexcept = default;
+	bigint_product_tree(const bigint* integers, size_type size, unsigned threads = 1);
+	explicit bigint_product_tree(const std::vector<bigint>& integers, unsigned threads = 1);
+
+public:
+	void reset() noexcept;
+	void swap(bigint_product_tree& tree) noexcept;
+
+	std::vector<bigint> remainders(const bigint_view& integer, unsigned threads = 1) const;
+	static std::vector<bigint> batch_gcd(const bigint* integers, size_type size, unsigned threads = 1);
+	static std::vector<bigint> batch_gcd(const std::vector<bigint>& integers, unsigned threads = 1);
+
+	bool empty() const noexcept;
+	size_type size() const noexcept;
+	size_type levels() const noexcept;
+	const std::vector<bigint>& level(size_type index) const;
+	const bigint& product() const;
+
+private:
+	std::vector<bigint> remainders_(const bigint_view& integer, bool squared, unsigned threads) const;
+
+private:
+	std::vector<std::vector<bigint>> levels_;
+};
+
+class bigfloat
+{
+public:
+	using size_type = std::size_t;
+	using exponent_type = std::int64_t;
+
+	enum class rounding
+	{
+		nearest,
+		toward_zero,
+		away_from_zero,
+		upward,
+		downward,
+	};
+
+	static constexpr size_type default_precision = 64;
+
+public:
+	bigfloat() noexcept = default;
+	bigfloat(const bigint_view& mantissa, exponent_type exponent = 0, size_type precision = default_precision, rounding mode = rounding::nearest);
+	explicit bigfloat(double value, size_type precision = default_precision, rounding mode = rounding::nearest);
+
+public:
+	bool operator==(const bigfloat& value) const noexcept;
+	bool operator!=(const bigfloat& value) const noexcept;
+	bool operator>(const bigfloat& value) const noexcept;
+	bool operator>=(const bigfloat& value) const noexcept;
+	bool operator<(const bigfloat& value) const noexcept;
+	bool operator<=(const bigfloat& value) const noexcept;
+	bigfloat operator+(const bigfloat& value) const;
+	bigfloat& operator+=(const bigfloat& value);
+	bigfloat operator-(const bigfloat& value) const;
+	bigfloat& operator-=(const bigfloat& value);
+	bigfloat operator*(const bigfloat& value) const;
+	bigfloat& operator*=(const bigfloat& value);
+	bigfloat operator/(const bigfloat& value) const;
+	bigfloat& operator/=(const bigfloat& value);
+	bigfloat operator-() const;
+	bool operator!() const noexcept;
+	explicit operator bool() const noexcept;
+
+public:
+	void swap(bigfloat& value) noexcept;
+
+	static bigfloat add(const bigfloat& a, const bigfloat& b, size_type precision, rounding mode);
+	static bigfloat sub(const bigfloat& a, const bigfloat& b, size_type precision, rounding mode);
+	static bigfloat mul(const bigfloat& a, const bigfloat& b, size_type precision, rounding mode);
+	static bigfloat div(const bigfloat& a, const bigfloat& b, size_type precision, rounding mode);
+	static bigfloat sqrt(const bigfloat& a, size_type precision, rounding mode);
+	bigfloat sqrt() const;
+
+	bool zero() const noexcept;
+	bool positive() const noexcept;
+	bool negative() const noexcept;
+
+	void set_precision(size_type precision);
+	void set_mode(rounding mode) noexcept;
+
+	bigint to_bigint() const;
+	double to_double() const noexcept;
+	std::string to_string(size_type digits = 0) const;
+
+private:
+	void round_(size_type precision, rounding mode, bool sticky);
+
+public:
+	const bigint& mantissa() const noexcept;
+	exponent_type exponent() const noexcept;
+	size_type precision() const noexcept;
+	rounding mode() const noexcept;
+
+private:
+	bigint mantissa_;
+	exponent_type exponent_ = 0;
+	size_type precision_ = default_precision;
+	rounding mode_ = rounding::nearest;
+};
+
+class bigrational
+{
+public:
+	using size_type = bigint::size_type;
+
+public:
+	bigrational();
+	bigrational(const bigint_view& integer);
+	bigrational(const bigint_view& numerator, const bigint_view& denominator);
+
+public:
+	bool operator==(const bigrational& value) const;
+	bool operator!=(const bigrational& value) const;
+	bool operator>(const bigrational& value) const;
+	bool operator>=(const bigrational& value) const;
+	bool operator<(const bigrational& value) const;
+	bool operator<=(const bigrational& value) const;
+	bigrational operator+(const bigrational& value) const;
+	bigrational& operator+=(const bigrational& value);
+	bigrational operator-(const bigrational& value) const;
+	bigrational& operator-=(const bigrational& value);
+	bigrational operator*(const bigrational& value) const;
+	bigrational& operator*=(const bigrational& value);
+	bigrational operator/(const bigrational& value) const;
+	bigrational& operator/=(const bigrational& value);
+	bigrational operator-() const;
+	bool operator!() const noexcept;
+	explicit operator bool() const noexcept;
+
+public:
+	void swap(bigrational& value) noexcept;
+
+	void normalize();
+	bool normalized() const noexcept;
+
+	bool zero() const noexcept;
+	bool positive() const noexcept;
+	bool negative() const noexcept;
+
+	bigfloat to_bigfloat(bigfloat::size_type precision = bigfloat::default_precision, bigfloat::rounding mode = bigfloat::rounding::nearest) const;
+	std::string to_string() const;
+
+private:
+	int compare_(const bigrational& value) const;
+	void grow_();
+
+public:
+	const bigint& numerator() const noexcept;
+	const bigint& denominator() const noexcept;
+
+private:
+	bigint numerator_;
+	bigint denominator_;
+	bool normalized_ = true;
+};
+
+class bigint_rns_basis
+{
+public:
+	using size_type = std::size_t;
+	using residue_type = std::uint32_t;
+
+public:
+	explicit bigint_rns_basis(size_type bits, unsigned threads = 1);
+	bigint_rns_basis(const bigint_rns_basis&) = delete;
+
+public:
+	bigint_rns_basis& operator=(const bigint_rns_basis&) = delete;
+
+public:
+	size_type size() const noexcept;
+	size_type bits() const noexcept;
+	unsigned threads() const noexcept;
+	const residue_type* primes() const noexcept;
+	const bigint& modulus() const noexcept;
+
+private:
+	std::vector<residue_type> primes_;
+	std::vector<residue_type> inverses_;
+	std::vector<residue_type> squares_;
+	std::vector<residue_type> garner_;
+	std::vector<residue_type> weights_;
+	bigint_product_tree tree_;
+	bigint half_;
+	size_type bits_;
+	unsigned threads_;
+
+	friend class bigint_rns;
+};
+
+class bigint_rns
+{
+public:
+	using size_type = bigint_rns_basis::size_type;
+	using residue_type = bigint_rns_basis::residue_type;
+
+public:
+	bigint_rns() noexcept = default;
+	explicit bigint_rns(const bigint_rns_basis& basis);
+	bigint_rns(const bigint_rns_basis& basis, const bigint_view& integer);
+
+public:
+	bool operator==(const bigint_rns& value) const;
+	bool operator!=(const bigint_rns& value) const;
+	bigint_rns operator+(const bigint_rns& value) const;
+	bigint_rns& operator+=(const bigint_rns& value);
+	bigint_rns operator-(const bigint_rns& value) const;
+	bigint_rns& operator-=(const bigint_rns& value);
+	bigint_rns operator*(const bigint_rns& value) const;
+	bigint_rns& operator*=(const bigint_rns& value);
+	bigint_rns operator-() const;
+
+public:
+	void swap(bigint_rns& value) noexcept;
+
+	bool zero() const noexcept;
+	bigint to_bigint() const;
+
+private:
+	void check_(const bigint_rns& value) const;
+
+public:
+	const bigint_rns_basis* basis() const noexcept;
+	const residue_type* data() const noexcept;
+	size_type size() const noexcept;
+
+private:
+	const bigint_rns_basis* basis_ = nullptr;
+	std::vector<residue_type> residues_;
 };
 
 #ifdef _BIGNUM_HAS_NAMESPACE
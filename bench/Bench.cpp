@@ -0,0 +1,783 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "BigNum.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#	include <x86intrin.h>
+#endif
+
+#ifdef _BIGNUM_HAS_NAMESPACE
+using namespace _BIGNUM_HAS_NAMESPACE;
+#endif
+
+/////////////////////////////////////////////////////////////////
+///// Allocation Counting
+/////////////////////////////////////////////////////////////////
+
+namespace
+{
+	bool counting = false;
+	std::uint64_t allocations = 0;
+}
+
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+#	define BIGNUM_BENCH_ALLOCATIONS
+
+extern "C"
+{
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t count, std::size_t size);
+	void* __libc_realloc(void* address, std::size_t size);
+	void __libc_free(void* address);
+
+	void* malloc(std::size_t size) noexcept
+	{
+		allocations += counting;
+		return __libc_malloc(size);
+	}
+	void* calloc(std::size_t count, std::size_t size) noexcept
+	{
+		allocations += counting;
+		return __libc_calloc(count, size);
+	}
+	void* realloc(void* address, std::size_t size) noexcept
+	{
+		allocations += counting;
+		return __libc_realloc(address, size);
+	}
+	void free(void* address) noexcept
+	{
+		__libc_free(address);
+	}
+}
+#endif
+
+/////////////////////////////////////////////////////////////////
+///// Benchmarks
+/////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct options
+	{
+		std::string filter;
+		std::size_t max_blocks = 10000000;
+		double min_time = 0.1;
+		std::string json;
+		std::string baseline;
+	};
+
+	struct result
+	{
+		std::string operation;
+		std::size_t blocks;
+		std::uint64_t iterations;
+		double ns_per_op;
+		double cycles_per_block;
+		double allocations_per_op;
+	};
+
+	using operation = std::function<void()>;
+
+	struct benchmark
+	{
+		const char* name;
+		std::size_t max_blocks;
+		std::function<operation(std::size_t)> prepare;
+	};
+
+	template<typename T>
+	void escape(T& value)
+	{
+#if defined(__GNUC__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static volatile void* sink;
+		sink = &value;
+#endif
+	}
+
+	std::uint64_t cycles() noexcept
+	{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return 0;
+#endif
+	}
+
+	bigint make_bigint(std::size_t blocks, std::uint64_t seed, bool sign = false)
+	{
+		std::uint64_t state = seed * 0x9E3779B97F4A7C15 + 1;
+		std::vector<bigint::block_type> data(blocks);
+
+		for (bigint::block_type& block : data)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			block = static_cast<bigint::block_type>(state);
+		}
+
+		data.back() |= 0x80000000;
+
+		return bigint(bigint_view(data.data(), blocks, sign));
+	}
+
+	// A blocks-sized mantissa at exactly its own precision, with the binary point a little below the top.
+	bigfloat make_bigfloat(std::size_t blocks, std::uint64_t seed)
+	{
+		return bigfloat(make_bigint(blocks, seed), -static_cast<bigfloat::exponent_type>(blocks * 32) + 7, blocks * 32);
+	}
+
+	// Numerator and denominator of blocks blocks each.
+	bigrational make_bigrational(std::size_t blocks, std::uint64_t seed)
+	{
+		return bigrational(make_bigint(blocks, seed), make_bigint(blocks, seed + 1));
+	}
+
+	// One block per leaf, so a tree over blocks leaves holds as many blocks as a blocks-sized integer.
+	std::vector<bigint> make_leaves(std::size_t blocks)
+	{
+		std::vector<bigint> leaves;
+
+		for (std::size_t i = 0; i < blocks; ++i)
+		{
+			leaves.push_back(make_bigint(1, i + 1));
+		}
+
+		return leaves;
+	}
+
+	std::vector<benchmark> benchmarks()
+	{
+		return
+		{
+			{ "construct", 1, [](std::size_t)
+			{
+				return operation([]()
+				{
+					bigint integer(std::int64_t(-1234567890123));
+
+					escape(integer);
+				});
+			} },
+			{ "construct_view", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				const bigint source = make_bigint(blocks, 1);
+
+				return operation([source]()
+				{
+					bigint integer(bigint_view(source.data(), source.capacity()));
+
+					escape(integer);
+				});
+			} },
+			{ "copy", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				const bigint source = make_bigint(blocks, 1);
+
+				return operation([source]()
+				{
+					bigint integer(source);
+
+					escape(integer);
+				});
+			} },
+			{ "assign", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				const bigint source = make_bigint(blocks, 1);
+				std::shared_ptr<bigint> target = std::make_shared<bigint>(make_bigint(blocks, 2));
+
+				return operation([source, target]()
+				{
+					*target = source;
+					escape(*target);
+				});
+			} },
+			{ "compare_equal", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks, 1);
+				const bigint b = a;
+
+				return operation([a, b]()
+				{
+					bool equal = a == b;
+
+					escape(equal);
+				});
+			} },
+			{ "compare_less", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks, 1);
+				const bigint b = a + bigint(1);
+
+				return operation([a, b]()
+				{
+					bool less = a < b;
+
+					escape(less);
+				});
+			} },
+			{ "add", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				std::shared_ptr<bigint> a = std::make_shared<bigint>(make_bigint(blocks, 1));
+				const bigint b = make_bigint(blocks, 2);
+
+				a->reserve(blocks + 1);
+
+				return operation([a, b]()
+				{
+					*a += b;
+					escape(*a);
+				});
+			} },
+			{ "add_new", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks, 1);
+				const bigint b = make_bigint(blocks, 2);
+
+				return operation([a, b]()
+				{
+					bigint sum = a + b;
+
+					escape(sum);
+				});
+			} },
+			{ "sub", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				std::shared_ptr<bigint> a = std::make_shared<bigint>(make_bigint(blocks + 1, 1));
+				const bigint b = make_bigint(blocks, 2);
+
+				return operation([a, b]()
+				{
+					*a -= b;
+					escape(*a);
+				});
+			} },
+			{ "increment", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				std::shared_ptr<bigint> a = std::make_shared<bigint>(make_bigint(blocks, 1));
+
+				return operation([a]()
+				{
+					++*a;
+					escape(*a);
+				});
+			} },
+			{ "multiply", 1 << 14, [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks, 1);
+				const bigint b = make_bigint(blocks, 2);
+
+				return operation([a, b]()
+				{
+					bigint product = a * b;
+
+					escape(product);
+				});
+			} },
+			{ "divide", 1 << 12, [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks * 2, 1);
+				const bigint b = make_bigint(blocks, 2);
+
+				return operation([a, b]()
+				{
+					bigint quotient = a / b;
+
+					escape(quotient);
+				});
+			} },
+			{ "modulo", 1 << 12, [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks * 2, 1);
+				const bigint b = make_bigint(blocks, 2);
+
+				return operation([a, b]()
+				{
+					bigint remainder = a % b;
+
+					escape(remainder);
+				});
+			} },
+			{ "is_prime", 1 << 6, [](std::size_t blocks)
+			{
+				const bigint a = bigint::next_prime(make_bigint(blocks, 1));
+
+				return operation([a]()
+				{
+					bool prime = a.is_probable_prime();
+
+					escape(prime);
+				});
+			} },
+			{ "next_prime", 1 << 4, [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks, 1);
+
+				return operation([a]()
+				{
+					bigint prime = bigint::next_prime(a);
+
+					escape(prime);
+				});
+			} },
+			{ "gcd", 1 << 12, [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks, 1);
+				const bigint b = make_bigint(blocks, 2);
+
+				return operation([a, b]()
+				{
+					bigint divisor = bigint::gcd(a, b);
+
+					escape(divisor);
+				});
+			} },
+			{ "product_tree", 1 << 14, [](std::size_t blocks)
+			{
+				std::shared_ptr<std::vector<bigint>> leaves = std::make_shared<std::vector<bigint>>(make_leaves(blocks));
+
+				return operation([leaves]()
+				{
+					bigint_product_tree tree(*leaves);
+
+					escape(tree);
+				});
+			} },
+			{ "remainders", 1 << 14, [](std::size_t blocks)
+			{
+				std::shared_ptr<bigint_product_tree> tree = std::make_shared<bigint_product_tree>(make_leaves(blocks));
+				const bigint a = make_bigint(blocks, 1);
+
+				return operation([tree, a]()
+				{
+					std::vector<bigint> remainders = tree->remainders(a);
+
+					escape(remainders);
+				});
+			} },
+			{ "batch_gcd", 1 << 12, [](std::size_t blocks)
+			{
+				std::shared_ptr<std::vector<bigint>> leaves = std::make_shared<std::vector<bigint>>(make_leaves(blocks));
+
+				return operation([leaves]()
+				{
+					std::vector<bigint> divisors = bigint_product_tree::batch_gcd(*leaves);
+
+					escape(divisors);
+				});
+			} },
+			{ "shift", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks, 1);
+
+				return operation([a]()
+				{
+					bigint shifted = a << 45;
+
+					escape(shifted);
+				});
+			} },
+			{ "shift_right", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks, 1);
+
+				return operation([a]()
+				{
+					bigint shifted = a >> 45;
+
+					escape(shifted);
+				});
+			} },
+			{ "float_add", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				const bigfloat a = make_bigfloat(blocks, 1);
+				const bigfloat b = make_bigfloat(blocks, 2);
+
+				return operation([a, b]()
+				{
+					bigfloat sum = a + b;
+
+					escape(sum);
+				});
+			} },
+			{ "float_mul", 1 << 14, [](std::size_t blocks)
+			{
+				const bigfloat a = make_bigfloat(blocks, 1);
+				const bigfloat b = make_bigfloat(blocks, 2);
+
+				return operation([a, b]()
+				{
+					bigfloat product = a * b;
+
+					escape(product);
+				});
+			} },
+			{ "float_div", 1 << 12, [](std::size_t blocks)
+			{
+				const bigfloat a = make_bigfloat(blocks, 1);
+				const bigfloat b = make_bigfloat(blocks, 2);
+
+				return operation([a, b]()
+				{
+					bigfloat quotient = a / b;
+
+					escape(quotient);
+				});
+			} },
+			{ "float_sqrt", 1 << 10, [](std::size_t blocks)
+			{
+				const bigfloat a = make_bigfloat(blocks, 1);
+
+				return operation([a]()
+				{
+					bigfloat root = a.sqrt();
+
+					escape(root);
+				});
+			} },
+			{ "rational_add", 1 << 10, [](std::size_t blocks)
+			{
+				const bigrational a = make_bigrational(blocks, 1);
+				const bigrational b = make_bigrational(blocks, 3);
+
+				return operation([a, b]()
+				{
+					bigrational sum = a + b;
+
+					escape(sum);
+				});
+			} },
+			{ "rational_mul", 1 << 10, [](std::size_t blocks)
+			{
+				const bigrational a = make_bigrational(blocks, 1);
+				const bigrational b = make_bigrational(blocks, 3);
+
+				return operation([a, b]()
+				{
+					bigrational product = a * b;
+
+					escape(product);
+				});
+			} },
+			{ "rational_compare", 1 << 12, [](std::size_t blocks)
+			{
+				const bigrational a = make_bigrational(blocks, 1);
+				const bigrational b = make_bigrational(blocks, 3);
+
+				return operation([a, b]()
+				{
+					bool less = a < b;
+
+					escape(less);
+				});
+			} },
+			{ "rational_normalize", 1 << 10, [](std::size_t blocks)
+			{
+				const bigint common = make_bigint(blocks, 5);
+				const bigrational a(make_bigint(blocks, 1) * common, make_bigint(blocks, 2) * common);
+
+				return operation([a]()
+				{
+					bigrational reduced = a;
+
+					reduced.normalize();
+					escape(reduced);
+				});
+			} },
+			{ "rns_from_bigint", 1 << 14, [](std::size_t blocks)
+			{
+				std::shared_ptr<bigint_rns_basis> basis = std::make_shared<bigint_rns_basis>(blocks * 32);
+				const bigint a = make_bigint(blocks, 1);
+
+				return operation([basis, a]()
+				{
+					bigint_rns residues(*basis, a);
+
+					escape(residues);
+				});
+			} },
+			{ "rns_to_bigint", 1 << 14, [](std::size_t blocks)
+			{
+				std::shared_ptr<bigint_rns_basis> basis = std::make_shared<bigint_rns_basis>(blocks * 32);
+				std::shared_ptr<bigint_rns> residues = std::make_shared<bigint_rns>(*basis, make_bigint(blocks, 1));
+
+				return operation([basis, residues]()
+				{
+					bigint integer = residues->to_bigint();
+
+					escape(integer);
+				});
+			} },
+			{ "rns_multiply", 1 << 14, [](std::size_t blocks)
+			{
+				std::shared_ptr<bigint_rns_basis> basis = std::make_shared<bigint_rns_basis>(blocks * 64);
+				std::shared_ptr<bigint_rns> a = std::make_shared<bigint_rns>(*basis, make_bigint(blocks, 1));
+				std::shared_ptr<bigint_rns> b = std::make_shared<bigint_rns>(*basis, make_bigint(blocks, 2));
+
+				return operation([basis, a, b]()
+				{
+					bigint_rns product = *a * *b;
+
+					escape(product);
+				});
+			} },
+			{ "to_string", 1 << 12, [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks, 1, true);
+
+				return operation([a]()
+				{
+					std::string string = a.to_string();
+
+					escape(string);
+				});
+			} },
+			{ "from_bytes", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				std::shared_ptr<std::vector<unsigned char>> bytes = std::make_shared<std::vector<unsigned char>>(blocks * sizeof(bigint::block_type));
+
+				make_bigint(blocks, 1).to_bytes(bytes->data(), bytes->size(), bigint::byte_order::big);
+
+				return operation([bytes]()
+				{
+					bigint integer = bigint::from_bytes(bytes->data(), bytes->size(), bigint::byte_order::big);
+
+					escape(integer);
+				});
+			} },
+			{ "to_bytes", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				const bigint a = make_bigint(blocks, 1);
+				std::shared_ptr<std::vector<unsigned char>> bytes = std::make_shared<std::vector<unsigned char>>(blocks * sizeof(bigint::block_type));
+
+				return operation([a, bytes]()
+				{
+					a.to_bytes(bytes->data(), bytes->size(), bigint::byte_order::big);
+					escape(*bytes);
+				});
+			} },
+			{ "accumulate", static_cast<std::size_t>(-1), [](std::size_t blocks)
+			{
+				std::shared_ptr<bigint_accumulator> accumulator = std::make_shared<bigint_accumulator>();
+				const bigint b = make_bigint(blocks, 2);
+
+				*accumulator += b;
+
+				return operation([accumulator, b]()
+				{
+					*accumulator += b;
+					escape(*accumulator);
+				});
+			} },
+		};
+	}
+
+	result run(const benchmark& benchmark, std::size_t blocks, double min_time)
+	{
+		const operation operation = benchmark.prepare(blocks);
+		const auto start = std::chrono::steady_clock::now();
+		const std::uint64_t start_cycles = cycles();
+
+		std::uint64_t iterations = 0;
+		std::uint64_t batch = 1;
+		double elapsed = 0;
+
+		allocations = 0;
+		counting = true;
+
+		while (elapsed < min_time)
+		{
+			for (std::uint64_t i = 0; i < batch; ++i)
+			{
+				operation();
+			}
+
+			iterations += batch;
+			batch *= 2;
+			elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		counting = false;
+
+		const std::uint64_t elapsed_cycles = cycles() - start_cycles;
+		result result;
+
+		result.operation = benchmark.name;
+		result.blocks = blocks;
+		result.iterations = iterations;
+		result.ns_per_op = elapsed * 1e9 / static_cast<double>(iterations);
+		result.cycles_per_block = static_cast<double>(elapsed_cycles) / static_cast<double>(iterations) / static_cast<double>(blocks);
+#ifdef BIGNUM_BENCH_ALLOCATIONS
+		result.allocations_per_op = static_cast<double>(allocations) / static_cast<double>(iterations);
+#else
+		result.allocations_per_op = -1;
+#endif
+
+		return result;
+	}
+
+	std::map<std::pair<std::string, std::size_t>, double> load_baseline(const std::string& path)
+	{
+		std::map<std::pair<std::string, std::size_t>, double> baseline;
+		std::ifstream file(path);
+		std::string line;
+
+		while (std::getline(file, line))
+		{
+			const std::size_t operation = line.find("\"operation\": \"");
+			const std::size_t blocks = line.find("\"blocks\": ");
+			const std::size_t ns_per_op = line.find("\"ns_per_op\": ");
+
+			if (operation == std::string::npos || blocks == std::string::npos || ns_per_op == std::string::npos) continue;
+
+			const std::size_t name_begin = operation + 14;
+			const std::string name = line.substr(name_begin, line.find('"', name_begin) - name_begin);
+
+			baseline[{ name, std::strtoull(line.c_str() + blocks + 10, nullptr, 10) }] = std::strtod(line.c_str() + ns_per_op + 13, nullptr);
+		}
+
+		return baseline;
+	}
+
+	bool parse_options(int argc, char** argv, options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string argument = argv[i];
+
+			if (i + 1 == argc) return false;
+			else if (argument == "--filter") options.filter = argv[++i];
+			else if (argument == "--max-blocks") options.max_blocks = std::strtoull(argv[++i], nullptr, 10);
+			else if (argument == "--min-time") options.min_time = std::strtod(argv[++i], nullptr) / 1000;
+			else if (argument == "--json") options.json = argv[++i];
+			else if (argument == "--baseline") options.baseline = argv[++i];
+			else return false;
+		}
+
+		return options.max_blocks > 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	options options;
+
+	if (!parse_options(argc, argv, options))
+	{
+		std::fprintf(stderr, "usage: %s [--filter name] [--max-blocks n] [--min-time ms] [--json path] [--baseline path]\n", argv[0]);
+		return 1;
+	}
+
+	const std::map<std::pair<std::string, std::size_t>, double> baseline = options.baseline.empty() ?
+		std::map<std::pair<std::string, std::size_t>, double>() : load_baseline(options.baseline);
+	std::vector<result> results;
+
+	std::vector<std::size_t> sizes;
+
+	for (std::size_t blocks = 1; blocks <= options.max_blocks; blocks *= 4)
+	{
+		sizes.push_back(blocks);
+	}
+
+	if (sizes.back() != options.max_blocks)
+	{
+		sizes.push_back(options.max_blocks);
+	}
+
+	std::printf("kernels: %s\n", bigint::kernel_name());
+	std::printf("%-16s %10s %12s %14s %14s %12s %10s %8s\n", "operation", "blocks", "ns/op", "ops/s", "blocks/s", "cycles/block", "allocs/op", "speedup");
+
+	for (const benchmark& benchmark : benchmarks())
+	{
+		if (!options.filter.empty() && !std::strstr(benchmark.name, options.filter.c_str())) continue;
+
+		for (std::size_t blocks : sizes)
+		{
+			if (blocks > benchmark.max_blocks) break;
+
+			const result result = run(benchmark, blocks, options.min_time);
+			const auto base = baseline.find({ result.operation, result.blocks });
+			char speedup[16] = "-";
+
+			if (base != baseline.end())
+			{
+				std::snprintf(speedup, sizeof(speedup), "%.2fx", base->second / result.ns_per_op);
+			}
+
+			std::printf("%-16s %10zu %12.1f %14.0f %14.0f %12.3f %10.2f %8s\n", result.operation.c_str(), result.blocks, result.ns_per_op,
+				1e9 / result.ns_per_op, 1e9 * static_cast<double>(result.blocks) / result.ns_per_op, result.cycles_per_block, result.allocations_per_op, speedup);
+			std::fflush(stdout);
+
+			results.push_back(result);
+		}
+	}
+
+	if (!options.json.empty())
+	{
+		std::FILE* const file = std::fopen(options.json.c_str(), "w");
+
+		if (!file)
+		{
+			std::fprintf(stderr, "cannot open %s\n", options.json.c_str());
+			return 1;
+		}
+
+		std::fprintf(file, "{\n\t\"version\": 1,\n\t\"results\": [\n");
+
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			const result& result = results[i];
+
+			std::fprintf(file, "\t\t{ \"operation\": \"%s\", \"blocks\": %zu, \"iterations\": %llu, \"ns_per_op\": %.3f, \"ops_per_second\": %.3f, "
+				"\"blocks_per_second\": %.3f, \"cycles_per_block\": %.4f, \"allocations_per_op\": %.4f }%s\n",
+				result.operation.c_str(), result.blocks, static_cast<unsigned long long>(result.iterations), result.ns_per_op, 1e9 / result.ns_per_op,
+				1e9 * static_cast<double>(result.blocks) / result.ns_per_op, result.cycles_per_block, result.allocations_per_op, i + 1 == results.size() ? "" : ",");
+		}
+
+		std::fprintf(file, "\t]\n}\n");
+		std::fclose(file);
+	}
+
+	return 0;
+}
@@ -0,0 +1,167 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstddef>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST(accumulator_sum)
+{
+	std::mt19937_64 random(4);
+	bigint_accumulator accumulator;
+	bigint expected;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		const bigint integer = random_bigint(random, 1 + random() % 20, random() % 2 != 0);
+
+		if (random() % 3)
+		{
+			accumulator += integer;
+			expected += integer;
+		}
+		else
+		{
+			accumulator -= integer;
+			expected -= integer;
+		}
+
+		if (i % 97 == 0)
+		{
+			CHECK(accumulator.value() == expected);
+		}
+		if (i % 211 == 0)
+		{
+			accumulator.normalize();
+			CHECK(accumulator.pending() == 0);
+		}
+	}
+
+	CHECK(accumulator.value() == expected);
+
+	const bigint_accumulator copy = accumulator;
+
+	accumulator -= expected;
+	CHECK(accumulator.value().zero() && !accumulator.value().negative());
+	CHECK(copy.value() == expected);
+
+	accumulator.reset();
+	CHECK(accumulator.value().zero() && accumulator.capacity() == 0);
+}
+TEST(accumulator_negative)
+{
+	bigint_accumulator accumulator;
+
+	accumulator -= bigint(std::uint64_t(1) << 40);
+	accumulator += bigint(1);
+	CHECK(accumulator.value().to_string() == "-1099511627775");
+
+	accumulator.normalize();
+	CHECK(accumulator.value().to_string() == "-1099511627775");
+
+	accumulator += bigint(std::uint64_t(1) << 41);
+	CHECK(accumulator.value().to_string() == "1099511627777");
+}
+TEST(concurrent_accumulator_sum)
+{
+	bigint_concurrent_accumulator accumulator;
+	std::vector<std::thread> threads;
+	const bigint step(std::uint64_t(0xFFFFFFFFFFFF));
+
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.emplace_back([&accumulator, &step, i]()
+		{
+			for (int j = 0; j < 5000; ++j)
+			{
+				accumulator += step;
+
+				if (j % 2)
+				{
+					accumulator -= bigint(i);
+				}
+			}
+		});
+	}
+
+	for (int i = 0; i < 10; ++i)
+	{
+		CHECK(!accumulator.value().negative());
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	CHECK(accumulator.shards() >= 1 && accumulator.shards() <= 4);
+	CHECK(accumulator.value() == step * bigint(20000) - bigint(6 * 2500));
+}
+TEST(concurrent_accumulator_adopt)
+{
+	bigint_concurrent_accumulator accumulator;
+
+	for (int i = 0; i < 8; ++i)
+	{
+		std::thread([&accumulator, i]()
+		{
+			accumulator += bigint(i + 1);
+		}).join();
+	}
+
+	// Every thread has exited before the next one starts, so each adopts the shard of the one before.
+	CHECK(accumulator.shards() == 1);
+	CHECK(accumulator.value() == bigint(36));
+
+	accumulator += bigint(4);
+	CHECK(accumulator.shards() == 1);
+
+	std::thread([&accumulator]()
+	{
+		accumulator -= bigint(10);
+	}).join();
+
+	// The shard adopted by this thread stays its own while it is alive.
+	CHECK(accumulator.shards() == 2);
+	CHECK(accumulator.value() == bigint(30));
+}
+TEST(concurrent_accumulator_headroom)
+{
+	bigint_concurrent_accumulator accumulator;
+	const bigint step(std::uint64_t(0xFFFFFFFF));
+	const bigint_view view = step;
+	const std::uint64_t count = (std::uint64_t(1) << 30) + 2;
+
+	for (std::uint64_t i = 0; i < count; ++i)
+	{
+		accumulator += view;
+	}
+
+	// Normalizing past the headroom carries into the top limb in place instead of growing the shard.
+	CHECK(accumulator.shards() == 1);
+	CHECK(accumulator.capacity() == 2);
+	CHECK(accumulator.value() == step * bigint(count));
+}
@@ -0,0 +1,106 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST(array_push)
+{
+	std::mt19937_64 random(5);
+	bigint_array array;
+	std::vector<bigint> expected;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		expected.push_back(i % 10 ? random_bigint(random, random() % 8, random() % 2 != 0) : bigint());
+		array.push_back(expected.back());
+	}
+
+	array.push_back(array[1]);
+	expected.push_back(expected[1]);
+
+	CHECK(array.size() == expected.size() && !array.empty());
+
+	for (std::size_t i = 0; i < expected.size(); ++i)
+	{
+		CHECK(array[i] == expected[i] && array[i].sign() == expected[i].sign());
+	}
+
+	CHECK_THROWS(array.at(array.size()), std::out_of_range);
+
+	const bigint_array copy = array;
+
+	CHECK(copy.size() == array.size() && copy.blocks() == array.blocks() && copy[17] == expected[17]);
+}
+TEST(array_file)
+{
+	const char* const path = "BigNumTest.array";
+	bigint_array array;
+
+	for (int i = -50; i < 50; ++i)
+	{
+		array.push_back(bigint(i) * bigint(std::int64_t(1) << 40));
+	}
+
+	array.save(path);
+
+	bigint_array mapped = bigint_array::load(path);
+
+	CHECK(mapped.mapped() && mapped.size() == 100);
+
+	for (std::size_t i = 0; i < 100; ++i)
+	{
+		CHECK(mapped[i] == array[i]);
+	}
+
+	mapped.push_back(bigint(7));
+	CHECK(!mapped.mapped() && mapped.size() == 101 && mapped[100] == bigint(7) && mapped[0] == array[0]);
+
+	bigint_array().save(path);
+	CHECK(bigint_array::load(path).empty());
+
+	std::FILE* const file = std::fopen(path, "wb");
+
+	std::fputs("not an array", file);
+	std::fclose(file);
+
+	CHECK_THROWS(bigint_array::load(path), std::runtime_error);
+
+	array.save(path);
+
+	// The offsets of the elements follow the header, and the blocks follow the offsets.
+	std::FILE* const corrupt = std::fopen(path, "r+b");
+	const std::uint64_t offset = std::uint64_t(1) << 32;
+
+	std::fseek(corrupt, 0, SEEK_END);
+	std::fseek(corrupt, std::ftell(corrupt) - static_cast<long>(array.blocks() * sizeof(bigint::block_type) + 100 * sizeof(std::uint64_t)), SEEK_SET);
+	std::fwrite(&offset, sizeof(offset), 1, corrupt);
+	std::fclose(corrupt);
+
+	CHECK_THROWS(bigint_array::load(path), std::runtime_error);
+	std::remove(path);
+}
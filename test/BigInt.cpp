@@ -0,0 +1,263 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+TEST(bigint_construct)
+{
+	CHECK(bigint().to_string() == "0");
+	CHECK(bigint(std::numeric_limits<std::int32_t>::min()).to_string() == "-2147483648");
+	CHECK(bigint(std::numeric_limits<std::int32_t>::max()).to_string() == "2147483647");
+	CHECK(bigint(std::numeric_limits<std::uint32_t>::max()).to_string() == "4294967295");
+	CHECK(bigint(std::numeric_limits<std::int64_t>::min()).to_string() == "-9223372036854775808");
+	CHECK(bigint(std::numeric_limits<std::int64_t>::max()).to_string() == "9223372036854775807");
+	CHECK(bigint(std::numeric_limits<std::uint64_t>::max()).to_string() == "18446744073709551615");
+	CHECK(bigint(0).zero() && !bigint(0).negative() && !bigint(0).positive());
+	CHECK(bigint(-1).negative() && bigint(1).positive());
+
+	const bigint integer(std::int64_t(-1234567890123));
+	const bigint copy(integer, 8);
+
+	CHECK(copy.capacity() == 8 && copy == integer);
+	CHECK_THROWS(bigint(copy, 1), std::invalid_argument);
+}
+TEST(bigint_assign)
+{
+	bigint integer(5);
+	const bigint other(std::uint64_t(1) << 40);
+
+	integer = other;
+	CHECK(integer == other);
+
+	integer = bigint(7);
+	CHECK(integer.to_string() == "7");
+
+	integer = std::move(integer);
+	CHECK(integer.to_string() == "7");
+
+	// Moving into an integer that holds blocks frees them, which the leak checker verifies.
+	bigint moved(std::uint64_t(1) << 50);
+
+	moved = bigint(-11);
+	CHECK(moved.to_string() == "-11");
+
+	bigint swapped(-3);
+
+	integer.swap(swapped);
+	CHECK(integer.to_string() == "-3" && swapped.to_string() == "7");
+}
+TEST(bigint_compare)
+{
+	bigint padded(5);
+
+	padded.reserve(10);
+
+	CHECK(padded == bigint(5) && !(padded != bigint(5)));
+	CHECK(bigint() == bigint(0) && bigint(0) == -bigint_view());
+	CHECK(bigint(-2) < bigint(-1) && bigint(-1) < bigint() && bigint() < bigint(1));
+	CHECK(bigint(std::uint64_t(1) << 32) > bigint(std::numeric_limits<std::uint32_t>::max()));
+	CHECK(bigint(std::int64_t(-(std::int64_t(1) << 32))) < bigint(-1));
+	CHECK(bigint(3) >= bigint(3) && bigint(3) <= bigint(3) && !(bigint(3) < bigint(3)));
+	CHECK(!bigint() && static_cast<bool>(bigint(-1)));
+}
+TEST(bigint_add_sub)
+{
+	std::mt19937_64 random(1);
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		const std::int64_t a = static_cast<std::int64_t>(random()) >> (2 + random() % 62);
+		const std::int64_t b = static_cast<std::int64_t>(random()) >> (2 + random() % 62);
+
+		CHECK(bigint(a) + bigint(b) == bigint(a + b));
+		CHECK(bigint(a) - bigint(b) == bigint(a - b));
+		CHECK((bigint(a) += bigint(a)) == bigint(a + a));
+		CHECK((bigint(a) -= bigint(a)).zero());
+	}
+
+	for (std::size_t blocks = 1; blocks < 64; blocks += 7)
+	{
+		const bigint a = random_bigint(random, blocks, random() % 2 != 0);
+		const bigint b = random_bigint(random, blocks + random() % 3, random() % 2 != 0);
+
+		CHECK(a + b - b == a);
+		CHECK(a - b + b == a);
+		CHECK(a + b == b + a);
+		CHECK((a - b) + (b - a) == bigint());
+		CHECK(!(a - a).negative());
+	}
+
+	const bigint max(std::numeric_limits<std::uint64_t>::max());
+
+	CHECK((max + bigint(1)).to_string() == "18446744073709551616");
+	CHECK((bigint() - max).to_string() == "-18446744073709551615");
+	CHECK((bigint(1) - (max + bigint(1))).to_string() == "-18446744073709551615");
+}
+TEST(bigint_increment)
+{
+	bigint integer(-2);
+
+	CHECK((++integer).to_string() == "-1");
+	CHECK((integer++).to_string() == "-1");
+	CHECK(integer.zero() && !integer.negative());
+	CHECK((++integer).to_string() == "1");
+
+	bigint carry(std::numeric_limits<std::uint64_t>::max());
+
+	CHECK((++carry).to_string() == "18446744073709551616");
+
+	bigint borrow(std::int64_t(-(std::int64_t(1) << 32)));
+
+	CHECK((++borrow).to_string() == "-4294967295");
+
+	bigint empty;
+
+	CHECK((++empty).to_string() == "1");
+}
+TEST(bigint_multiply)
+{
+	std::mt19937_64 random(2);
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		const std::int64_t a = static_cast<std::int64_t>(random()) >> (33 + random() % 31);
+		const std::int64_t b = static_cast<std::int64_t>(random()) >> (33 + random() % 31);
+
+		CHECK(bigint(a) * bigint(b) == bigint(a * b));
+	}
+
+	for (std::size_t blocks = 1; blocks < 80; blocks += 9)
+	{
+		const bigint a = random_bigint(random, blocks, random() % 2 != 0);
+		const bigint b = random_bigint(random, blocks / 2 + 1, random() % 2 != 0);
+		const bigint c = random_bigint(random, blocks + 3, random() % 2 != 0);
+
+		CHECK(a * b == b * a);
+		CHECK((a + b) * c == a * c + b * c);
+		CHECK((a * bigint()).zero() && !(a * bigint()).negative());
+	}
+
+	const bigint max(std::numeric_limits<std::uint64_t>::max());
+
+	CHECK((max * max).to_string() == "340282366920938463426481119284349108225");
+	CHECK((bigint(-3) *= bigint(4)).to_string() == "-12");
+}
+TEST(bigint_divide)
+{
+	std::mt19937_64 random(3);
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		const std::int64_t a = static_cast<std::int64_t>(random()) >> (random() % 62);
+		const std::int64_t b = (static_cast<std::int64_t>(random()) >> (1 + random() % 62)) | 1;
+
+		CHECK(bigint(a) / bigint(b) == bigint(a / b));
+		CHECK(bigint(a) % bigint(b) == bigint(a % b));
+	}
+
+	for (std::size_t blocks = 1; blocks < 80; blocks += 7)
+	{
+		const bigint a = random_bigint(random, blocks + random() % 40, random() % 2 != 0);
+		const bigint b = random_bigint(random, blocks, random() % 2 != 0) + bigint(1);
+
+		bigint quotient, remainder;
+
+		bigint::divmod(a, b, quotient, remainder);
+		CHECK(quotient * b + remainder == a);
+		CHECK(remainder.zero() || remainder.negative() == a.negative());
+		CHECK((remainder.negative() ? -bigint_view(remainder) : bigint_view(remainder)) < (b.negative() ? -bigint_view(b) : bigint_view(b)));
+		CHECK((a * b) / b == a && ((a * b) % b).zero());
+	}
+
+	// Blocks near the edges of the range make the quotient estimate overshoot.
+	const std::uint32_t edges[] = { 0, 1, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFE, 0xFFFFFFFF };
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		bigint a, b;
+
+		for (std::size_t j = 0; j < 6; ++j)
+		{
+			a = (a << 32) + bigint(edges[random() % 6]);
+		}
+
+		for (std::size_t j = 0; j < 3; ++j)
+		{
+			b = (b << 32) + bigint(edges[random() % 6]);
+		}
+
+		if (b.zero()) continue;
+
+		CHECK((a / b) * b + a % b == a && a % b < b);
+	}
+
+	bigint integer(17);
+
+	bigint::divmod(integer, bigint(5), integer, integer);
+	CHECK(integer == bigint(2));
+	CHECK((bigint(-7) / bigint(2)).to_string() == "-3" && (bigint(-7) % bigint(2)).to_string() == "-1");
+	CHECK_THROWS(bigint(1) / bigint(), std::invalid_argument);
+}
+TEST(bigint_capacity)
+{
+	bigint integer(std::uint64_t(0xFFFFFFFF00000001));
+
+	integer.reserve(16);
+	CHECK(integer.capacity() == 16);
+
+	integer.shrink_to_fit();
+	CHECK(integer.capacity() == 2 && integer.to_string() == "18446744069414584321");
+
+	// A nonzero top block is kept when the capacity already fits.
+	integer.shrink_to_fit();
+	CHECK(integer.capacity() == 2 && integer.to_string() == "18446744069414584321");
+
+	integer -= integer;
+	integer.shrink_to_fit();
+	CHECK(integer.capacity() == 0 && integer.zero());
+
+	integer = bigint(-9);
+	integer.reset();
+	CHECK(integer.capacity() == 0 && !integer.sign());
+}
+TEST(bigint_to_string)
+{
+	CHECK(bigint(std::uint64_t(1000000000)).to_string() == "1000000000");
+	CHECK(bigint(std::int64_t(-999999999999999999)).to_string() == "-999999999999999999");
+
+	bigint power(1);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		power *= bigint(10);
+	}
+
+	CHECK(power.to_string() == "1" + std::string(100, '0'));
+}
@@ -0,0 +1,81 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <random>
+
+TEST(file_add_sub)
+{
+	std::mt19937_64 random(6);
+
+	for (int i = 0; i < 20; ++i)
+	{
+		const bigint a = random_bigint(random, 1 + random() % (i < 15 ? 100 : 10000), random() % 2 != 0);
+		const bigint b = random_bigint(random, 1 + random() % (i < 15 ? 100 : 10000), random() % 2 != 0);
+		bigint_file file(a);
+
+		CHECK(file == a && file <= a && !(file < a));
+		CHECK(file.capacity() >= a.capacity());
+
+		file += b;
+		CHECK(file == a + b);
+
+		file -= a;
+		CHECK(file == b);
+
+		file -= b;
+		CHECK(file.zero() && !file.negative());
+
+		file = a;
+		file += file;
+		CHECK(file == a + a);
+
+		file -= file;
+		CHECK(file.zero());
+	}
+}
+TEST(file_multiply)
+{
+	std::mt19937_64 random(7);
+
+	for (int i = 0; i < 6; ++i)
+	{
+		const bigint a = random_bigint(random, 1 + random() % (i < 4 ? 300 : 6000), random() % 2 != 0);
+		const bigint b = random_bigint(random, 1 + random() % (i < 4 ? 300 : 6000), random() % 2 != 0);
+		bigint_file file(a);
+
+		file *= b;
+		CHECK(file == a * b);
+
+		bigint_file result;
+
+		bigint_file::multiply(result, b, a);
+		CHECK(result == a * b && bigint(result) == file);
+	}
+
+	bigint_file zero(bigint(5));
+
+	zero *= bigint();
+	CHECK(zero.zero() && !zero.negative());
+}
@@ -0,0 +1,140 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+TEST(bigfloat_double)
+{
+	std::mt19937_64 random(21);
+	std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		const double a = distribution(random) * std::ldexp(1.0, static_cast<int>(random() % 200) - 100);
+		const double b = distribution(random);
+		const bigfloat x(a, 53), y(b, 53);
+
+		CHECK(x.to_double() == a);
+		CHECK((x + y).to_double() == a + b);
+		CHECK((x - y).to_double() == a - b);
+		CHECK((x * y).to_double() == a * b);
+		CHECK((x / y).to_double() == a / b);
+		CHECK(bigfloat::sqrt(bigfloat(std::fabs(a), 53), 53, bigfloat::rounding::nearest).to_double() == std::sqrt(std::fabs(a)));
+		CHECK((x < y) == (a < b) && (x == y) == (a == b));
+	}
+
+	CHECK((bigfloat(1.0, 53) + bigfloat(std::ldexp(1.0, -60), 53)).to_double() == 1.0);
+	CHECK((bigfloat(1e300, 53) * bigfloat(1e300, 53)).to_double() == INFINITY);
+
+	// Subnormals round once, on the bits they can hold.
+	const double denorm = std::ldexp(1.0, -1074);
+
+	CHECK(bigfloat(bigint((std::uint64_t(1) << 59) + 1), -1134, 64).to_double() == denorm);
+	CHECK(bigfloat((bigint(1) << 100) + bigint(1), -1175, 128).to_double() == denorm);
+	CHECK(bigfloat(bigint(1), -1075, 64).to_double() == 0.0);
+	CHECK(bigfloat(bigint(3), -1075, 64).to_double() == 2 * denorm);
+	CHECK(bigfloat(bigint(1), -5000, 64).to_double() == 0.0);
+	CHECK(bigfloat(bigint(-5), -1076, 64).to_double() == -denorm);
+	CHECK_THROWS(bigfloat(NAN), std::invalid_argument);
+}
+TEST(bigfloat_rounding)
+{
+	using rounding = bigfloat::rounding;
+
+	const bigfloat one(bigint(1), 0, 4), three(bigint(3), 0, 4);
+
+	CHECK(bigfloat::div(one, three, 4, rounding::nearest) == bigfloat(bigint(11), -5, 4));
+	CHECK(bigfloat::div(one, three, 4, rounding::toward_zero) == bigfloat(bigint(5), -4, 4));
+	CHECK(bigfloat::div(one, three, 4, rounding::upward) == bigfloat(bigint(11), -5, 4));
+	CHECK(bigfloat::div(-one, three, 4, rounding::upward) == bigfloat(bigint(-5), -4, 4));
+	CHECK(bigfloat::div(-one, three, 4, rounding::downward) == bigfloat(bigint(-11), -5, 4));
+	CHECK(bigfloat::div(-one, three, 4, rounding::away_from_zero) == bigfloat(bigint(-11), -5, 4));
+
+	// Ties go to the even neighbour.
+	CHECK(bigfloat(bigint(17), 0, 4) == bigfloat(bigint(16), 0, 4) && bigfloat(bigint(19), 0, 4) == bigfloat(bigint(20), 0, 4));
+	CHECK(bigfloat(bigint(17), 0, 4, rounding::away_from_zero) == bigfloat(bigint(18), 0, 4));
+
+	// A far smaller addend only decides the direction.
+	const bigfloat tiny(bigint(1), -1000, 8);
+
+	CHECK(bigfloat::add(one, tiny, 8, rounding::nearest) == one);
+	CHECK(bigfloat::add(one, tiny, 8, rounding::upward) == bigfloat(bigint(129), -7, 8));
+	CHECK(bigfloat::sub(one, tiny, 8, rounding::downward) == bigfloat(bigint(255), -8, 8));
+	CHECK(bigfloat::sub(one, tiny, 8, rounding::toward_zero) == bigfloat(bigint(255), -8, 8));
+	CHECK(bigfloat::sub(one, tiny, 8, rounding::upward) == one);
+
+	// Operands wider than precision plus a guard block are cut before multiplying, but the product is still rounded exactly.
+	const bigfloat wide(bigint(std::uint64_t(285140015469569)), 0, 64), small(bigint(3), 0, 64);
+
+	CHECK(bigfloat::mul(wide, small, 8, rounding::nearest) == bigfloat(bigint(194), 42, 8));
+	CHECK(bigfloat::mul(-wide, small, 8, rounding::nearest) == bigfloat(bigint(-194), 42, 8));
+	CHECK(bigfloat::mul(wide, small, 8, rounding::upward) == bigfloat(bigint(195), 42, 8));
+	CHECK(bigfloat::mul(wide, small, 8, rounding::toward_zero) == bigfloat(bigint(194), 42, 8));
+	CHECK(bigfloat::mul(wide, wide, 8, rounding::nearest) == bigfloat(bigint(std::uint64_t(285140015469569)) * bigint(std::uint64_t(285140015469569)), 0, 8));
+
+	std::mt19937_64 random(39);
+
+	for (int i = 0; i < 200; ++i)
+	{
+		const bigint x = random_bigint(random, 1 + random() % 6, true), y = random_bigint(random, 1 + random() % 6, true);
+		const rounding mode = static_cast<rounding>(random() % 5);
+
+		CHECK(bigfloat::mul(bigfloat(x, 0, 256), bigfloat(y, 0, 256), 8, mode) == bigfloat(x * y, 0, 8, mode));
+	}
+
+	bigfloat value(bigint(255), 0, 8);
+
+	value.set_precision(4);
+	CHECK(value == bigfloat(bigint(256), 0, 4) && value.mantissa() == bigint(1) && value.exponent() == 8);
+	CHECK_THROWS(value.set_precision(0), std::invalid_argument);
+	CHECK_THROWS(one / bigfloat(), std::invalid_argument);
+	CHECK_THROWS(bigfloat::sqrt(-one, 8, rounding::nearest), std::invalid_argument);
+}
+TEST(bigfloat_precision)
+{
+	const bigfloat two(bigint(2), 0, 1000);
+	const bigfloat root = two.sqrt();
+
+	CHECK(root.precision() == 1000 && (root.mantissa() >> 1000).zero());
+	CHECK(root.to_string(50) == "1.4142135623730950488016887242096980785696718753769");
+	CHECK((root * root - two) < bigfloat(bigint(1), -990) && (two - root * root) < bigfloat(bigint(1), -990));
+	CHECK(bigfloat::sqrt(bigfloat(bigint(1) << 400, 0, 1000), 1000, bigfloat::rounding::nearest) == bigfloat(bigint(1) << 200));
+
+	const bigfloat third = bigfloat(bigint(1), 0, 200) / bigfloat(bigint(3), 0, 200);
+
+	CHECK(third.to_string(30) == "3.33333333333333333333333333333e-1");
+	CHECK(bigfloat(-0.375).to_string() == "-3.75e-1" && bigfloat(bigint(12345), 0, 64).to_string() == "1.2345e4");
+	CHECK((bigfloat(bigint(7) << 300, 0, 64) / bigfloat(bigint(2), 0, 64)).to_bigint() == bigint(7) << 299);
+	CHECK(bigfloat(-2.75).to_bigint() == bigint(-2) && bigfloat(0.25).to_bigint().zero() && !bigfloat(-0.25).to_bigint().negative());
+
+	// A wide operand is cut before multiplying but the product still rounds faithfully.
+	const bigfloat wide(bigint(1) << 5000, -5000, 6000);
+	const bigfloat product = bigfloat::mul(wide + bigfloat(bigint(1), -5500, 6000), bigfloat(bigint(3), 0, 64), 64, bigfloat::rounding::nearest);
+
+	CHECK(product == bigfloat(bigint(3), 0, 64));
+}
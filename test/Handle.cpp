@@ -0,0 +1,80 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST(handle_share)
+{
+	const bigint_handle handle(bigint(std::uint64_t(1) << 50));
+	bigint_handle copy = handle;
+
+	CHECK(handle.use_count() == 2 && !handle.unique());
+	CHECK(&*copy == &*handle);
+	CHECK(copy->to_string() == "1125899906842624");
+
+	++copy.mutate();
+	CHECK(handle.use_count() == 1 && copy.unique());
+	CHECK(handle->to_string() == "1125899906842624" && copy->to_string() == "1125899906842625");
+
+	const bigint_handle moved = std::move(copy);
+
+	CHECK(copy.use_count() == 0 && copy->zero() && moved.unique());
+
+	bigint_handle empty;
+
+	CHECK(empty.get().zero());
+
+	empty.mutate() = bigint(3);
+	CHECK(static_cast<const bigint&>(empty) == bigint(3));
+}
+TEST(handle_threads)
+{
+	const bigint_handle handle(bigint(42));
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.emplace_back([handle]()
+		{
+			for (int j = 0; j < 10000; ++j)
+			{
+				bigint_handle copy = handle;
+				bigint_handle other;
+
+				other = copy;
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	CHECK(handle.unique() && *handle == bigint(42));
+}
@@ -0,0 +1,115 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	bigint power_of_two(std::size_t exponent)
+	{
+		std::vector<bigint::block_type> blocks(exponent / 32 + 1);
+
+		blocks.back() = static_cast<bigint::block_type>(1) << (exponent % 32);
+
+		return bigint(bigint_view(blocks.data(), blocks.size(), false));
+	}
+}
+
+TEST(kernels_name)
+{
+	CHECK(bigint::kernel_name() != nullptr && std::strlen(bigint::kernel_name()) > 0);
+}
+TEST(kernels_multiply)
+{
+	std::mt19937_64 random(34);
+
+	for (std::size_t a_blocks = 1; a_blocks < 40; ++a_blocks)
+	{
+		for (std::size_t b_blocks = 1; b_blocks < 12; ++b_blocks)
+		{
+			const bigint a = random_bigint(random, a_blocks, random() % 2 != 0);
+			const bigint b = random_bigint(random, b_blocks, random() % 2 != 0);
+
+			CHECK(a * b == reference_multiply(a, b));
+		}
+	}
+
+	std::vector<bigint::block_type> ones(37, 0xFFFFFFFF);
+	const bigint max(bigint_view(ones.data(), ones.size(), false));
+
+	CHECK(max * max == reference_multiply(max, max));
+	CHECK(max + bigint(1) == power_of_two(37 * 32));
+	CHECK(power_of_two(37 * 32) - bigint(1) == max);
+}
+TEST(kernels_compare)
+{
+	std::mt19937_64 random(35);
+
+	for (std::size_t blocks = 1; blocks < 70; ++blocks)
+	{
+		const bigint a = random_bigint(random, blocks);
+		bigint b = a;
+
+		CHECK(a == b);
+
+		b.data()[random() % blocks] ^= 1;
+		CHECK(a != b);
+		CHECK((a < b) == (a - b).negative());
+		CHECK((a > b) == (b - a).negative());
+	}
+}
+TEST(kernels_shift)
+{
+	std::mt19937_64 random(36);
+
+	for (std::size_t blocks = 1; blocks < 60; blocks += 3)
+	{
+		const bigint a = random_bigint(random, blocks, random() % 2 != 0);
+
+		for (std::size_t shift : { std::size_t(0), std::size_t(1), std::size_t(31), std::size_t(32), std::size_t(33), std::size_t(100), std::size_t(517) })
+		{
+			const bigint shifted = a << shift;
+
+			CHECK(shifted == a * power_of_two(shift));
+			CHECK(shifted >> shift == a);
+			CHECK((bigint(a) <<= shift) == shifted);
+
+			const bigint quotient = a >> shift;
+			const bigint remainder = a - quotient * power_of_two(shift);
+
+			CHECK(!remainder.negative() && remainder < power_of_two(shift));
+		}
+	}
+
+	CHECK((bigint(-5) >> 1).to_string() == "-3");
+	CHECK((bigint(-4) >> 1).to_string() == "-2");
+	CHECK((bigint(-1) >> 100).to_string() == "-1");
+	CHECK((bigint(7) >> 100).zero() && !(bigint(7) >> 100).negative());
+	CHECK((bigint() << 5).zero());
+	CHECK((bigint_view(bigint(3)) << 33).to_string() == "25769803776");
+}
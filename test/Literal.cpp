@@ -0,0 +1,54 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+namespace
+{
+	constexpr bigint_view p256 = 115792089237316195423570985008687907853269984665640564039457584007908834671663_big;
+	constexpr bigint_view mask = 0xFFFF'FFFF'0000'0000'0000'0001_big;
+
+	static_assert(p256.capacity() == 8 && p256.data()[0] == 0xFFFFFC2F && p256.data()[7] == 0xFFFFFFFF, "decimal literal");
+	static_assert(mask.capacity() == 3 && mask.data()[0] == 1 && mask.data()[1] == 0 && mask.data()[2] == 0xFFFFFFFF, "hex literal");
+	static_assert(0b1011_big .data()[0] == 11 && 0755_big .data()[0] == 0755, "binary and octal literals");
+	static_assert(0_big .capacity() == 0 && 0x0000_big .capacity() == 0, "zero literals");
+	static_assert((-42_big).sign() && (-42_big).data()[0] == 42, "negative literal");
+}
+
+TEST(literal_value)
+{
+	CHECK(p256.to_string() == "115792089237316195423570985008687907853269984665640564039457584007908834671663");
+	CHECK(mask == bigint(std::uint64_t(0xFFFFFFFF00000000)) * bigint(std::uint64_t(1) << 32) + bigint(1));
+	CHECK((-42_big).to_string() == "-42");
+	CHECK(0_big .zero() && !(-0_big).negative());
+	CHECK(1'000'000_big == bigint(1000000));
+}
+TEST(literal_arithmetic)
+{
+	const bigint a = p256 - 1_big;
+
+	CHECK(a + 1_big == p256);
+	CHECK(p256 * 2_big - p256 == p256);
+	CHECK((p256 >> 224) == 0xFFFFFFFF_big);
+	CHECK(bigint(p256) == p256);
+}
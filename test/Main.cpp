@@ -0,0 +1,123 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <vector>
+
+namespace
+{
+	int failures = 0;
+}
+
+test_registrar::test_registrar(test_case& test) noexcept
+{
+	test.next = test_cases();
+	test_cases() = &test;
+}
+
+test_case*& test_cases() noexcept
+{
+	static test_case* head = nullptr;
+
+	return head;
+}
+void test_failed(const char* file, int line, const char* expression)
+{
+	std::printf("%s(%d): CHECK(%s) failed\n", file, line, expression);
+	++failures;
+}
+
+bigint random_bigint(std::mt19937_64& random, std::size_t blocks, bool sign)
+{
+	std::vector<unsigned char> bytes(blocks * sizeof(bigint::block_type));
+
+	for (unsigned char& byte : bytes)
+	{
+		byte = static_cast<unsigned char>(random());
+	}
+
+	if (blocks)
+	{
+		bytes.back() |= 0x80;
+	}
+
+	return bigint::from_bytes(bytes.data(), bytes.size(), bigint::byte_order::little, sign);
+}
+bigint reference_multiply(const bigint& a, const bigint& b)
+{
+	std::vector<bigint::block_type> product(a.capacity() + b.capacity() + 1);
+
+	for (std::size_t i = 0; i < a.capacity(); ++i)
+	{
+		std::uint64_t carry = 0;
+
+		for (std::size_t j = 0; j < b.capacity(); ++j)
+		{
+			carry += static_cast<std::uint64_t>(a.data()[i]) * b.data()[j] + product[i + j];
+			product[i + j] = static_cast<bigint::block_type>(carry);
+			carry >>= 32;
+		}
+
+		product[i + b.capacity()] = static_cast<bigint::block_type>(carry);
+	}
+
+	return bigint(bigint_view(product.data(), product.size(), a.negative() != b.negative()));
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<test_case*> tests;
+
+	for (test_case* test = test_cases(); test; test = test->next)
+	{
+		if (argc < 2 || std::strstr(test->name, argv[1]))
+		{
+			tests.insert(tests.begin(), test);
+		}
+	}
+
+	for (test_case* test : tests)
+	{
+		const int old_failures = failures;
+
+		try
+		{
+			test->function();
+		}
+		catch (const std::exception& exception)
+		{
+			test_failed(test->name, 0, exception.what());
+		}
+
+		std::printf("[%s] %s\n", failures == old_failures ? "PASS" : "FAIL", test->name);
+	}
+
+	std::printf("%zu tests, %d failures\n", tests.size(), failures);
+
+	return failures ? 1 : 0;
+}
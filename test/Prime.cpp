@@ -0,0 +1,115 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstdint>
+#include <vector>
+
+TEST(prime_small)
+{
+	std::vector<bool> composite(20000, false);
+
+	for (std::uint32_t i = 2; i < composite.size(); ++i)
+	{
+		CHECK(bigint(i).is_probable_prime() == !composite[i]);
+
+		for (std::uint32_t j = i * 2; j < composite.size(); j += i)
+		{
+			composite[j] = true;
+		}
+	}
+
+	CHECK(!bigint(0).is_probable_prime() && !bigint(1).is_probable_prime());
+	CHECK(!bigint(-7).is_probable_prime());
+}
+TEST(prime_pseudoprimes)
+{
+	// Carmichael numbers and strong pseudoprimes to base 2 must be caught by the Lucas test.
+	const std::uint64_t composites[] =
+	{
+		561, 1105, 1729, 2047, 3277, 4033, 4681, 8321, 15841, 29341, 42799, 49141, 52633, 65281, 74665, 80581,
+		85489, 88357, 90751, 3215031751, 2152302898747, 3474749660383, 341550071728321, 3825123056546413051,
+	};
+
+	for (std::uint64_t composite : composites)
+	{
+		CHECK(!bigint(composite).is_probable_prime());
+		CHECK(!bigint(composite).is_probable_prime(8));
+	}
+
+	CHECK(!(bigint(std::uint64_t(4294967291)) * bigint(std::uint64_t(4294967279))).is_probable_prime());
+	CHECK(!(bigint(std::uint64_t(65537)) * bigint(std::uint64_t(65537))).is_probable_prime());
+}
+TEST(prime_large)
+{
+	constexpr bigint_view p256 = 115792089237316195423570985008687907853269984665640564039457584007908834671663_big;
+	const bigint mersenne = (bigint(1) << 127) - bigint(1);
+	const bigint mersenne_521 = (bigint(1) << 521) - bigint(1);
+
+	CHECK(p256.is_probable_prime() && p256.is_probable_prime(16));
+	CHECK(mersenne.is_probable_prime() && mersenne_521.is_probable_prime(4));
+	CHECK(!((bigint(1) << 128) - bigint(1)).is_probable_prime());
+	CHECK(!(mersenne * bigint(p256)).is_probable_prime());
+	CHECK(!(mersenne * mersenne).is_probable_prime());
+	CHECK(!bigint(-bigint_view(p256)).is_probable_prime());
+
+	// Montgomery products switch to Karatsuba past the threshold.
+	const bigint_thresholds saved = bigint_thresholds::get();
+
+	bigint_thresholds::set({ 4, saved.toom3 });
+	CHECK(p256.is_probable_prime() && mersenne_521.is_probable_prime());
+	CHECK(!(mersenne * bigint(p256)).is_probable_prime());
+	bigint_thresholds::set(saved);
+}
+TEST(prime_next)
+{
+	CHECK(bigint::next_prime(bigint(-5)) == bigint(2));
+	CHECK(bigint::next_prime(bigint(2)) == bigint(3));
+	CHECK(bigint::next_prime(bigint(4093)) == bigint(4099));
+	CHECK(bigint::next_prime(bigint(std::uint64_t(4294967291))) == bigint(std::uint64_t(4294967311)));
+	CHECK(bigint::next_prime(bigint(1) << 64) == (bigint(1) << 64) + bigint(13));
+	CHECK(bigint::next_prime(bigint(1) << 128, 0, 4) == (bigint(1) << 128) + bigint(51));
+
+	// A maximal prime gap of 1132 follows 1693182318746371.
+	CHECK(bigint::next_prime(bigint(std::uint64_t(1693182318746371))) == bigint(std::uint64_t(1693182318747503)));
+}
+TEST(prime_filter)
+{
+	std::vector<bigint> integers;
+
+	for (std::uint32_t i = 0; i < 200; ++i)
+	{
+		integers.push_back((bigint(1) << 89) + bigint(i));
+	}
+
+	const std::vector<bigint> primes = bigint::filter_primes(integers, 2, 3);
+
+	CHECK(primes == bigint::filter_primes(integers, 2, 1));
+	CHECK(!primes.empty() && primes.front() == bigint::next_prime((bigint(1) << 89) - bigint(1)));
+
+	for (std::size_t i = 1; i < primes.size(); ++i)
+	{
+		CHECK(primes[i - 1] < primes[i] && bigint::next_prime(primes[i - 1]) == primes[i]);
+	}
+}
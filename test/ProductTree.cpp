@@ -0,0 +1,110 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST(product_tree_product)
+{
+	std::mt19937_64 random(11);
+	std::vector<bigint> integers;
+	bigint product(1);
+
+	for (std::size_t i = 0; i < 37; ++i)
+	{
+		integers.push_back(random_bigint(random, 1 + random() % 9, random() % 2 != 0));
+		product *= integers.back();
+	}
+
+	const bigint_product_tree tree(integers, 3);
+
+	CHECK(tree.size() == 37 && tree.levels() == 7);
+	CHECK(tree.product() == product && tree.level(0) == integers);
+	CHECK(bigint_product_tree(integers, 1).product() == product);
+	CHECK(tree.level(1).size() == 19 && tree.level(1)[18] == integers[36]);
+	CHECK_THROWS(tree.level(7), std::out_of_range);
+
+	const bigint_product_tree empty;
+
+	CHECK(empty.empty() && empty.product() == bigint(1) && empty.remainders(bigint(5)).empty());
+}
+TEST(product_tree_remainders)
+{
+	std::mt19937_64 random(12);
+	std::vector<bigint> moduli;
+
+	for (std::size_t i = 0; i < 100; ++i)
+	{
+		moduli.push_back(random_bigint(random, 1 + random() % 4) + bigint(1));
+	}
+
+	const bigint_product_tree tree(moduli);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		const bigint integer = random_bigint(random, 1 + random() % 600, i % 2 != 0);
+		const std::vector<bigint> remainders = tree.remainders(integer, i + 1);
+
+		CHECK(remainders.size() == moduli.size());
+
+		for (std::size_t j = 0; j < moduli.size(); ++j)
+		{
+			CHECK(remainders[j] == integer % moduli[j]);
+		}
+	}
+
+	CHECK_THROWS(bigint_product_tree(std::vector<bigint>{ bigint(3), bigint() }).remainders(bigint(7)), std::invalid_argument);
+}
+TEST(product_tree_batch_gcd)
+{
+	std::vector<bigint> primes;
+	bigint prime(std::uint64_t(1) << 40);
+
+	for (int i = 0; i < 12; ++i)
+	{
+		primes.push_back(prime = bigint::next_prime(prime));
+	}
+
+	// Keys 0 and 5 share a factor, as do 3, 7 and 9.
+	const std::vector<bigint> keys =
+	{
+		primes[0] * primes[1], primes[2] * primes[3], primes[4] * primes[5], primes[6] * primes[7], primes[8] * primes[9], primes[0] * primes[10],
+		bigint(std::uint64_t(4294967291)), primes[6] * primes[11], bigint(std::uint64_t(4294967279)), primes[7] * primes[11],
+	};
+	const std::vector<bigint> gcds = bigint_product_tree::batch_gcd(keys, 2);
+
+	CHECK(gcds.size() == keys.size());
+	CHECK(gcds[0] == primes[0] && gcds[5] == primes[0]);
+	CHECK(gcds[3] == keys[3] && gcds[7] == keys[7] && gcds[9] == keys[9]);
+	CHECK(gcds[1] == bigint(1) && gcds[2] == bigint(1) && gcds[4] == bigint(1) && gcds[6] == bigint(1) && gcds[8] == bigint(1));
+	CHECK(gcds == bigint_product_tree::batch_gcd(keys.data(), keys.size(), 1));
+
+	CHECK(bigint::gcd(bigint(-12), bigint(18)) == bigint(6));
+	CHECK(bigint::gcd(bigint(), bigint(-7)) == bigint(7) && bigint::gcd(bigint(), bigint()).zero());
+	CHECK(bigint::gcd(primes[0] * primes[1], primes[1] * primes[2]) == primes[1]);
+}
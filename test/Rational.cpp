@@ -0,0 +1,108 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+TEST(bigrational_normalize)
+{
+	bigrational value(bigint(-12), bigint(-18));
+
+	CHECK(!value.normalized() && value.numerator() == bigint(12) && value.denominator() == bigint(18));
+	CHECK(value == bigrational(bigint(2), bigint(3)) && value.to_string() == "2/3");
+
+	value.normalize();
+	CHECK(value.normalized() && value.numerator() == bigint(2) && value.denominator() == bigint(3));
+
+	CHECK(bigrational(bigint(0), bigint(-5)).normalized() && bigrational(bigint(0), bigint(-5)).denominator() == bigint(1));
+	CHECK(bigrational(bigint(10), bigint(-5)).to_string() == "-2" && bigrational(bigint(7)).to_string() == "7");
+	CHECK_THROWS(bigrational(bigint(1), bigint()), std::invalid_argument);
+}
+TEST(bigrational_arithmetic)
+{
+	std::mt19937_64 random(31);
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		const std::int64_t a = static_cast<std::int64_t>(random() % 2001) - 1000, b = static_cast<std::int64_t>(random() % 1000) + 1;
+		const std::int64_t c = static_cast<std::int64_t>(random() % 2001) - 1000, d = static_cast<std::int64_t>(random() % 1000) + 1;
+
+		bigrational x = bigrational(bigint(a), bigint(b)), y = bigrational(bigint(c), bigint(d));
+
+		if (i % 2)
+		{
+			x.normalize();
+			y.normalize();
+		}
+
+		const bigrational sum = x + y, difference = x - y, product = x * y;
+
+		CHECK(sum == bigrational(bigint(a * d + c * b), bigint(b * d)));
+		CHECK(difference == bigrational(bigint(a * d - c * b), bigint(b * d)));
+		CHECK(product == bigrational(bigint(a * c), bigint(b * d)));
+		CHECK((x < y) == (a * d < c * b) && (x == y) == (a * d == c * b));
+
+		if (c)
+		{
+			CHECK(x / y == bigrational(bigint(a * d), bigint(b * c)));
+		}
+
+		// Henrici's method keeps results of reduced operands reduced.
+		if (i % 2)
+		{
+			CHECK(sum.normalized() && bigint::gcd(sum.numerator(), sum.denominator()) == bigint(1));
+			CHECK(product.normalized() && bigint::gcd(product.numerator(), product.denominator()) == bigint(1));
+			CHECK(sum.denominator().positive() && product.denominator().positive());
+		}
+	}
+
+	CHECK_THROWS(bigrational(bigint(1)) / bigrational(), std::invalid_argument);
+	CHECK((-bigrational(bigint(3), bigint(4))).to_string() == "-3/4" && !(-bigrational()).negative());
+}
+TEST(bigrational_lazy)
+{
+	// Sums of unreduced fractions stay unreduced until they grow past the threshold.
+	bigrational sum(bigint(0), bigint(1));
+	bigrational harmonic;
+	bool reduced = false;
+
+	for (std::int32_t i = 1; i <= 400; ++i)
+	{
+		sum += bigrational(bigint(2), bigint(2 * i));
+		harmonic += bigrational(bigint(1), bigint(i));
+
+		CHECK(harmonic.normalized());
+		reduced |= i > 1 && sum.normalized();
+	}
+
+	CHECK(reduced && !bigrational(bigint(2), bigint(4)).normalized());
+	CHECK(sum == harmonic && sum.to_string() == harmonic.to_string());
+
+	const bigfloat value = harmonic.to_bigfloat(53);
+
+	CHECK(value.to_double() > 6.5699 && value.to_double() < 6.5700);
+	CHECK(bigrational(bigint(1), bigint(3)).to_bigfloat(4) == bigfloat(bigint(11), -5, 4));
+}
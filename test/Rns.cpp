@@ -0,0 +1,104 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	void check_chain(const bigint_rns_basis& basis, std::mt19937_64& random, std::size_t blocks)
+	{
+		// Horner evaluation of a random polynomial, once exactly and once without carries.
+		std::vector<bigint> coefficients;
+
+		for (int i = 0; i < 6; ++i)
+		{
+			coefficients.push_back(random_bigint(random, blocks, random() % 2 != 0));
+		}
+
+		const bigint x = random_bigint(random, blocks, true);
+		bigint exact;
+		bigint_rns residues(basis), point(basis, x);
+
+		for (const bigint& coefficient : coefficients)
+		{
+			exact = exact * x + coefficient;
+			residues = residues * point + bigint_rns(basis, coefficient);
+		}
+
+		CHECK(residues.to_bigint() == exact);
+		CHECK((residues - bigint_rns(basis, exact)).zero());
+		CHECK((-residues).to_bigint() == bigint(-bigint_view(exact)));
+	}
+}
+
+TEST(rns_small_basis)
+{
+	std::mt19937_64 random(41);
+	const bigint_rns_basis basis(1000);
+
+	CHECK(basis.size() == 34 && basis.bits() == 1000);
+	CHECK(basis.primes()[0] == 0x7FFFFFFF && (basis.modulus() >> 1001) != bigint());
+
+	for (int i = 0; i < 20; ++i)
+	{
+		check_chain(basis, random, 5);
+	}
+
+	const bigint half = basis.modulus() >> 1;
+
+	CHECK(bigint_rns(basis, half).to_bigint() == half);
+	CHECK(bigint_rns(basis, half + bigint(1)).to_bigint() == half + bigint(1) - basis.modulus());
+	CHECK(bigint_rns(basis, bigint(-1)).to_bigint() == bigint(-1) && bigint_rns(basis).to_bigint().zero());
+	CHECK(bigint_rns(basis, bigint(6)) * bigint_rns(basis, bigint(-7)) == bigint_rns(basis, bigint(-42)));
+}
+TEST(rns_large_basis)
+{
+	std::mt19937_64 random(42);
+	const bigint_rns_basis basis(6000, 2);
+
+	CHECK(basis.size() == 201);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		check_chain(basis, random, 30);
+	}
+
+	const bigint_rns_basis other(6000);
+
+	CHECK_THROWS(bigint_rns(basis) + bigint_rns(other), std::invalid_argument);
+	CHECK_THROWS(bigint_rns() * bigint_rns(), std::invalid_argument);
+}
+TEST(rns_parallel)
+{
+	std::mt19937_64 random(43);
+	const bigint_rns_basis basis(150000, 3);
+	const bigint a = random_bigint(random, 2000, true), b = random_bigint(random, 2000);
+
+	CHECK(basis.size() > 4096);
+	CHECK((bigint_rns(basis, a) * bigint_rns(basis, b) + bigint_rns(basis, b)).to_bigint() == a * b + b);
+}
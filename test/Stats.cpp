@@ -0,0 +1,112 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+	bigint_stats::counter_type total_allocations(const bigint_stats& stats)
+	{
+		bigint_stats::counter_type result = 0;
+
+		for (std::size_t i = 0; i < bigint_stats::sites; ++i)
+		{
+			result += stats.allocations[i] + stats.reallocations[i];
+		}
+
+		return result;
+	}
+}
+
+TEST(stats_names)
+{
+	CHECK(std::strcmp(bigint_stats::name(bigint_stats::site::construct), "construct") == 0);
+	CHECK(std::strcmp(bigint_stats::name(bigint_stats::site::array), "array") == 0);
+	CHECK(std::strcmp(bigint_stats::name(bigint_stats::operation::multiply), "multiply") == 0);
+	CHECK(std::strcmp(bigint_stats::name(bigint_stats::operation::accumulate), "accumulate") == 0);
+}
+TEST(stats_disabled)
+{
+	if (bigint_stats::enabled) return;
+
+	bigint_stats::reset();
+
+	bigint a = 12345;
+	a *= a;
+	a += a;
+
+	const bigint_stats stats = bigint_stats::snapshot();
+
+	CHECK(total_allocations(stats) == 0);
+	CHECK(stats.calls[static_cast<std::size_t>(bigint_stats::operation::multiply)] == 0);
+}
+TEST(stats_enabled)
+{
+	if (!bigint_stats::enabled) return;
+
+	bigint_stats::reset();
+
+	bigint a = 12345;
+	const bigint b = a;
+	bigint c = a * b;
+
+	c += a;
+	c.reserve(64);
+	CHECK(c.to_string() == "152411370");
+
+	unsigned char bytes[8];
+
+	c.to_bytes(bytes, sizeof(bytes));
+
+	const bigint_stats stats = bigint_stats::snapshot();
+
+	CHECK(stats.allocations[static_cast<std::size_t>(bigint_stats::site::construct)] == 1);
+	CHECK(stats.allocations[static_cast<std::size_t>(bigint_stats::site::copy)] == 1);
+	CHECK(stats.allocations[static_cast<std::size_t>(bigint_stats::site::multiply)] == 1);
+	CHECK(stats.reallocations[static_cast<std::size_t>(bigint_stats::site::reserve)] == 1);
+	CHECK(stats.bytes[static_cast<std::size_t>(bigint_stats::site::reserve)] == 64 * sizeof(bigint::block_type));
+	CHECK(stats.calls[static_cast<std::size_t>(bigint_stats::operation::multiply)] == 1);
+	CHECK(stats.calls[static_cast<std::size_t>(bigint_stats::operation::add)] == 1);
+	CHECK(stats.calls[static_cast<std::size_t>(bigint_stats::operation::to_string)] == 1);
+	CHECK(stats.sizes[static_cast<std::size_t>(bigint_stats::operation::multiply)][1] == 1);
+	CHECK(stats.sizes[static_cast<std::size_t>(bigint_stats::operation::to_bytes)][1] == 1);
+
+	std::thread([]
+	{
+		bigint d = 1;
+
+		for (int i = 0; i < 10; ++i)
+		{
+			d += d;
+		}
+	}).join();
+
+	CHECK(bigint_stats::snapshot().calls[static_cast<std::size_t>(bigint_stats::operation::add)] == 11);
+
+	bigint_stats::reset();
+	CHECK(total_allocations(bigint_stats::snapshot()) == 0);
+}
@@ -0,0 +1,70 @@
+#ifndef _BIGNUM_TEST_HPP
+#define _BIGNUM_TEST_HPP
+
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "BigNum.hpp"
+
+#include <cstddef>
+#include <random>
+
+#ifdef _BIGNUM_HAS_NAMESPACE
+using namespace _BIGNUM_HAS_NAMESPACE;
+#endif
+
+struct test_case
+{
+	const char* name;
+	void(*function)();
+	test_case* next;
+};
+
+struct test_registrar
+{
+	explicit test_registrar(test_case& test) noexcept;
+};
+
+test_case*& test_cases() noexcept;
+void test_failed(const char* file, int line, const char* expression);
+
+bigint random_bigint(std::mt19937_64& random, std::size_t blocks, bool sign = false);
+bigint reference_multiply(const bigint& a, const bigint& b);
+
+#define TEST(name) \
+	static void name##_test_(); \
+	static test_case name##_case_ = { #name, name##_test_, nullptr }; \
+	static const test_registrar name##_registrar_(name##_case_); \
+	static void name##_test_()
+
+#define CHECK(expression) ((expression) ? static_cast<void>(0) : test_failed(__FILE__, __LINE__, #expression))
+
+#define CHECK_THROWS(expression, exception) \
+	do \
+	{ \
+		bool thrown_ = false; \
+		try { expression; } catch (const exception&) { thrown_ = true; } \
+		if (!thrown_) test_failed(__FILE__, __LINE__, #expression " throws " #exception); \
+	} while (false)
+
+#endif
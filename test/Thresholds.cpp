@@ -0,0 +1,107 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	struct thresholds_guard
+	{
+		const bigint_thresholds saved = bigint_thresholds::get();
+
+		~thresholds_guard()
+		{
+			bigint_thresholds::set(saved);
+		}
+	};
+}
+
+TEST(thresholds_multiply)
+{
+	const thresholds_guard guard;
+	const bigint_thresholds settings[] = { { 2, 1000000 }, { 3, 3 }, { 4, 9 }, { 8, 24 }, { 1000000, 5 } };
+	std::mt19937_64 random(35);
+
+	for (const bigint_thresholds& thresholds : settings)
+	{
+		bigint_thresholds::set(thresholds);
+
+		for (std::size_t a_blocks = 1; a_blocks < 90; a_blocks += 1 + a_blocks / 4)
+		{
+			for (std::size_t b_blocks = 1; b_blocks <= a_blocks; b_blocks += 1 + b_blocks / 3)
+			{
+				const bigint a = random_bigint(random, a_blocks, random() % 2 != 0);
+				const bigint b = random_bigint(random, b_blocks, random() % 2 != 0);
+				const bigint expected = reference_multiply(a, b);
+
+				CHECK(a * b == expected);
+				CHECK(b * a == expected);
+			}
+		}
+
+		std::vector<bigint::block_type> ones(61, 0xFFFFFFFF);
+		const bigint max(bigint_view(ones.data(), ones.size(), false));
+
+		CHECK(max * max == reference_multiply(max, max));
+		CHECK(max * bigint(max, 80) == reference_multiply(max, max));
+	}
+}
+TEST(thresholds_set)
+{
+	const thresholds_guard guard;
+
+	CHECK_THROWS(bigint_thresholds::set({ 1, 100 }), std::invalid_argument);
+	CHECK_THROWS(bigint_thresholds::set({ 10, 2 }), std::invalid_argument);
+
+	bigint_thresholds::set({ 12, 34 });
+	CHECK(bigint_thresholds::get().karatsuba == 12 && bigint_thresholds::get().toom3 == 34);
+}
+TEST(thresholds_save_load)
+{
+	const char* const path = "thresholds_test.txt";
+	const bigint_thresholds thresholds = { 21, 143 };
+
+	thresholds.save(path);
+
+	const bigint_thresholds loaded = bigint_thresholds::load(path);
+
+	CHECK(loaded.karatsuba == 21 && loaded.toom3 == 143);
+
+	std::FILE* const file = std::fopen(path, "w");
+
+	std::fputs("# tuned\ntoom3 99\nfuture 7\n", file);
+	std::fclose(file);
+
+	CHECK(bigint_thresholds::load(path).toom3 == 99);
+	CHECK(bigint_thresholds::load(path).karatsuba == bigint_thresholds::defaults().karatsuba);
+
+	std::remove(path);
+
+	CHECK_THROWS(bigint_thresholds::load(path), std::runtime_error);
+}
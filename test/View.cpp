@@ -0,0 +1,97 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Test.hpp"
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST(view_operand)
+{
+	const bigint::block_type blocks[] = { 0xFFFFFFFF, 0xFFFFFFFF, 0 };
+	const bigint_view view(blocks, 3);
+
+	CHECK(view == bigint(std::uint64_t(0xFFFFFFFFFFFFFFFF)));
+	CHECK(bigint(std::uint64_t(0xFFFFFFFFFFFFFFFF)) == view);
+	CHECK((-view).negative() && -view < view);
+	CHECK((view + bigint(1)).to_string() == "18446744073709551616");
+	CHECK((view - view).zero());
+	CHECK((view * view).to_string() == "340282366920938463426481119284349108225");
+	CHECK(view.to_string() == "18446744073709551615");
+	CHECK((-view).to_string() == "-18446744073709551615");
+
+	bigint integer(1);
+
+	integer += view;
+	integer -= -view;
+	CHECK(integer.to_string() == "36893488147419103231");
+
+	const bigint copy(view);
+
+	CHECK(copy == view && copy.capacity() == 3);
+	CHECK(bigint_view().zero() && !bigint_view() && bigint_view().to_string() == "0");
+}
+TEST(view_bytes)
+{
+	const unsigned char big[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+	const bigint from_big = bigint::from_bytes(big, sizeof(big), bigint::byte_order::big);
+	const bigint from_little = bigint::from_bytes(big, sizeof(big), bigint::byte_order::little, true);
+
+	CHECK(from_big == bigint(std::uint64_t(0x01020304050607)));
+	CHECK(from_little == bigint(-std::int64_t(0x07060504030201)));
+	CHECK(from_big.byte_size() == 7 && bigint().byte_size() == 0);
+
+	unsigned char bytes[9];
+
+	from_big.to_bytes(bytes, sizeof(bytes), bigint::byte_order::big);
+	CHECK(bytes[0] == 0 && bytes[1] == 0 && bytes[2] == 0x01 && bytes[8] == 0x07);
+
+	from_big.to_bytes(bytes, sizeof(bytes), bigint::byte_order::little);
+	CHECK(bytes[0] == 0x07 && bytes[6] == 0x01 && bytes[7] == 0 && bytes[8] == 0);
+
+	CHECK_THROWS(from_big.to_bytes(bytes, 6), std::invalid_argument);
+	CHECK(bigint::from_bytes(bytes, 0).zero());
+
+	std::mt19937_64 random(3);
+
+	for (std::size_t size = 1; size < 40; ++size)
+	{
+		std::vector<unsigned char> source(size);
+
+		for (unsigned char& byte : source)
+		{
+			byte = static_cast<unsigned char>(random());
+		}
+
+		for (bigint::byte_order order : { bigint::byte_order::little, bigint::byte_order::big })
+		{
+			const bigint integer = bigint::from_bytes(source.data(), size, order);
+			std::vector<unsigned char> target(size);
+
+			integer.to_bytes(target.data(), size, order);
+			CHECK(target == source);
+		}
+	}
+}
@@ -0,0 +1,222 @@
+/* MIT License
+ *
+ * Copyright (c) 2018 kmc7468, kiwiyou
+ *
+ * Permission is hereby granted, reset of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "BigNum.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _BIGNUM_HAS_NAMESPACE
+using namespace _BIGNUM_HAS_NAMESPACE;
+#endif
+
+namespace
+{
+	struct options
+	{
+		std::size_t max_blocks = 4096;
+		double min_time = 0.02;
+		std::string config;
+		std::string header;
+	};
+
+	using thresholds_at = std::function<bigint_thresholds(std::size_t)>;
+
+	template<typename T>
+	void escape(T& value)
+	{
+#if defined(__GNUC__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static volatile void* sink;
+		sink = &value;
+#endif
+	}
+
+	bigint make_bigint(std::size_t blocks, std::uint64_t seed)
+	{
+		std::uint64_t state = seed * 0x9E3779B97F4A7C15 + 1;
+		std::vector<bigint::block_type> data(blocks);
+
+		for (bigint::block_type& block : data)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			block = static_cast<bigint::block_type>(state);
+		}
+
+		data.back() |= 0x80000000;
+
+		return bigint(bigint_view(data.data(), blocks, false));
+	}
+
+	// The best of three runs, in nanoseconds per multiplication.
+	double time_multiply(const bigint& a, const bigint& b, const bigint_thresholds& thresholds, double min_time)
+	{
+		using clock = std::chrono::steady_clock;
+
+		double best = std::numeric_limits<double>::max();
+
+		bigint_thresholds::set(thresholds);
+
+		for (int run = 0; run < 3; ++run)
+		{
+			const clock::time_point start = clock::now();
+			std::uint64_t iterations = 0;
+			double elapsed;
+
+			do
+			{
+				bigint product = a * b;
+
+				escape(product);
+				++iterations;
+				elapsed = std::chrono::duration<double>(clock::now() - start).count();
+			} while (elapsed < min_time);
+
+			best = std::min(best, elapsed * 1e9 / static_cast<double>(iterations));
+		}
+
+		return best;
+	}
+
+	// Returns the first sampled size from which the higher algorithm wins three samples in a row, or last + 1 if it never does.
+	std::size_t find_crossover(const char* name, std::size_t first, std::size_t last, const thresholds_at& lower, const thresholds_at& higher, const options& options)
+	{
+		std::size_t crossover = 0;
+		int wins = 0;
+
+		for (std::size_t blocks = first; blocks <= last; blocks += std::max<std::size_t>(1, blocks / 8))
+		{
+			const bigint a = make_bigint(blocks, 1);
+			const bigint b = make_bigint(blocks, 2);
+			const double lower_time = time_multiply(a, b, lower(blocks), options.min_time);
+			const double higher_time = time_multiply(a, b, higher(blocks), options.min_time);
+
+			std::printf("%-10s %10zu %14.1f %14.1f %8.3f\n", name, blocks, lower_time, higher_time, lower_time / higher_time);
+			std::fflush(stdout);
+
+			if (higher_time < lower_time)
+			{
+				if (wins++ == 0)
+				{
+					crossover = blocks;
+				}
+				if (wins == 3) return crossover;
+			}
+			else
+			{
+				wins = 0;
+			}
+		}
+
+		return wins ? crossover : last + 1;
+	}
+
+	void write_header(const std::string& path, const bigint_thresholds& thresholds)
+	{
+		std::FILE* const file = std::fopen(path.c_str(), "w");
+
+		if (!file) throw std::runtime_error("cannot open " + path);
+
+		std::fprintf(file, "// Generated by bignum-tune with the %s kernels.\n", bigint::kernel_name());
+		std::fprintf(file, "#define _BIGNUM_KARATSUBA_THRESHOLD %zu\n", thresholds.karatsuba);
+		std::fprintf(file, "#define _BIGNUM_TOOM3_THRESHOLD %zu\n", thresholds.toom3);
+
+		if (std::fclose(file) != 0) throw std::runtime_error("cannot write " + path);
+	}
+
+	bool parse_options(int argc, char** argv, options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string argument = argv[i];
+
+			if (i + 1 == argc) return false;
+			else if (argument == "--max-blocks") options.max_blocks = std::strtoull(argv[++i], nullptr, 10);
+			else if (argument == "--min-time") options.min_time = std::strtod(argv[++i], nullptr) / 1000;
+			else if (argument == "--config") options.config = argv[++i];
+			else if (argument == "--header") options.header = argv[++i];
+			else return false;
+		}
+
+		return options.max_blocks >= 16;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	options options;
+
+	if (!parse_options(argc, argv, options))
+	{
+		std::fprintf(stderr, "usage: %s [--max-blocks n] [--min-time ms] [--config path] [--header path]\n", argv[0]);
+		return 1;
+	}
+
+	const std::size_t never = std::numeric_limits<std::size_t>::max();
+
+	std::printf("kernels: %s\n", bigint::kernel_name());
+	std::printf("%-10s %10s %14s %14s %8s\n", "threshold", "blocks", "lower ns/op", "higher ns/op", "speedup");
+
+	// At the threshold itself the higher algorithm runs once at the top and the lower one below it.
+	const std::size_t karatsuba = find_crossover("karatsuba", 4, std::min<std::size_t>(options.max_blocks, 512),
+		[never](std::size_t blocks) { return bigint_thresholds{ blocks + 1, never }; },
+		[never](std::size_t blocks) { return bigint_thresholds{ blocks, never }; }, options);
+	const std::size_t toom3 = find_crossover("toom3", std::max<std::size_t>(karatsuba * 2, 16), options.max_blocks,
+		[karatsuba](std::size_t blocks) { return bigint_thresholds{ karatsuba, blocks + 1 }; },
+		[karatsuba](std::size_t blocks) { return bigint_thresholds{ karatsuba, blocks }; }, options);
+	const bigint_thresholds thresholds = { karatsuba, toom3 };
+
+	bigint_thresholds::set(thresholds);
+	std::printf("\nkaratsuba %zu\ntoom3 %zu\n", thresholds.karatsuba, thresholds.toom3);
+
+	try
+	{
+		if (!options.config.empty())
+		{
+			thresholds.save(options.config.c_str());
+		}
+		if (!options.header.empty())
+		{
+			write_header(options.header, thresholds);
+		}
+	}
+	catch (const std::exception& exception)
+	{
+		std::fprintf(stderr, "%s\n", exception.what());
+		return 1;
+	}
+
+	return 0;
+}